@@ -0,0 +1,119 @@
+/***********************************************
+  AMPI message matching benchmark
+
+  Measures the cost of matching a message against a queue of
+  D entries, for D from 1 up to a maximum depth:
+
+  posted:     rank 0 posts D MPI_Irecv's with distinct tags and rank 1
+              sends the matching messages in the reverse order, so each
+              arriving message matches the most recently posted request.
+  unexpected: rank 1 sends D messages with distinct tags before rank 0
+              receives them in the reverse order, so each receive
+              matches the most recently arrived message.
+ **********************************************/
+
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static double run_posted(int depth, int iters, int rank)
+{
+  MPI_Request* reqs = (MPI_Request*)malloc(depth * sizeof(MPI_Request));
+  int* bufs = (int*)malloc(depth * sizeof(int));
+  double start = 0, elapsed = 0;
+  int it, i;
+
+  for (it = 0; it < iters; it++)
+  {
+    if (rank == 0)
+    {
+      for (i = 0; i < depth; i++)
+        MPI_Irecv(&bufs[i], 1, MPI_INT, 1, i, MPI_COMM_WORLD, &reqs[i]);
+      MPI_Barrier(MPI_COMM_WORLD);
+      start = MPI_Wtime();
+      MPI_Waitall(depth, reqs, MPI_STATUSES_IGNORE);
+      elapsed += MPI_Wtime() - start;
+    }
+    else
+    {
+      MPI_Barrier(MPI_COMM_WORLD);
+      for (i = depth - 1; i >= 0; i--)
+        MPI_Send(&i, 1, MPI_INT, 0, i, MPI_COMM_WORLD);
+    }
+  }
+
+  free(reqs);
+  free(bufs);
+  return elapsed;
+}
+
+static double run_unexpected(int depth, int iters, int rank)
+{
+  double start = 0, elapsed = 0;
+  int it, i, val;
+
+  for (it = 0; it < iters; it++)
+  {
+    if (rank == 0)
+    {
+      MPI_Barrier(MPI_COMM_WORLD);
+      start = MPI_Wtime();
+      for (i = depth - 1; i >= 0; i--)
+        MPI_Recv(&val, 1, MPI_INT, 1, i, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+      elapsed += MPI_Wtime() - start;
+    }
+    else
+    {
+      for (i = 0; i < depth; i++)
+        MPI_Send(&i, 1, MPI_INT, 0, i, MPI_COMM_WORLD);
+      MPI_Barrier(MPI_COMM_WORLD);
+    }
+  }
+
+  return elapsed;
+}
+
+int main(int argc, char** argv)
+{
+  int rank, size, depth, max_depth = 4096, iters = 10;
+  double posted, unexpected;
+
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  if (argc > 1) max_depth = atoi(argv[1]);
+  if (argc > 2) iters = atoi(argv[2]);
+
+  if (size < 2)
+  {
+    if (rank == 0) fprintf(stderr, "matching needs at least 2 ranks, run with +vp2\n");
+    MPI_Finalize();
+    return 1;
+  }
+
+  if (rank == 0)
+  {
+    printf("Matching cost per message (rank 0 <- rank 1, %d iterations)\n", iters);
+    printf("%8s %16s %16s\n", "depth", "posted (us)", "unexpected (us)");
+  }
+
+  for (depth = 1; depth <= max_depth; depth *= 2)
+  {
+    if (rank > 1)
+    {
+      /* Idle ranks only take part in the barriers */
+      int it;
+      for (it = 0; it < 2 * iters; it++) MPI_Barrier(MPI_COMM_WORLD);
+      continue;
+    }
+    posted = run_posted(depth, iters, rank);
+    unexpected = run_unexpected(depth, iters, rank);
+    if (rank == 0)
+      printf("%8d %16.3f %16.3f\n", depth, 1e6 * posted / ((double)depth * iters),
+             1e6 * unexpected / ((double)depth * iters));
+  }
+
+  MPI_Finalize();
+  return 0;
+}
@@ -3,6 +3,7 @@
 set(conv-core-h-sources
     src/util/cmitls.h
     src/conv-core/cmipool.h
+    src/conv-core/cmimsgalloc.h
     src/conv-core/cmishmem.h
     src/conv-core/cmidemangle.h
     src/conv-core/conv-config.h
@@ -33,6 +34,7 @@ set(conv-core-h-sources
 
 set(conv-core-cxx-sources
     src/conv-core/cmipool.C
+    src/conv-core/cmimsgalloc.C
     src/conv-core/conv-conds.C
     src/conv-core/conv-rdma.C
     src/conv-core/conv-rdmadevice.C
@@ -19,11 +19,13 @@
    and are used for the udp retransmission protocol implementation.
    The parameter root is for the communication library and is used in
    broadcast. The cmaMsgType field is used to distinguish
-   between a REG, CMA_MD and CMA_ACK message
+   between a REG, CMA_MD and CMA_ACK message. The message size shares a
+   64-bit word with the flag bits, so messages may exceed 4 GB without
+   growing the header.
 */
 #define CMK_MSG_HEADER_BASIC   CMK_MSG_HEADER_EXT
 
-#define CMK_MSG_HEADER_EXT_    CmiUInt2 d0,d1,d2,d3,hdl,type,xhdl,info,redID,rank; CmiInt4 root, size; CmiUInt1 zcMsgType:4, cmaMsgType:2, nokeep:1;
+#define CMK_MSG_HEADER_EXT_    CmiUInt2 d0,d1,d2,d3,hdl,type,xhdl,info,redID,rank; CmiInt4 root; CmiUInt8 size:56, zcMsgType:4, cmaMsgType:2, nokeep:1;
 
 #define CMK_MSG_HEADER_EXT       { CMK_MSG_HEADER_EXT_ }
 
@@ -59,3 +61,7 @@
 #define CMK_CMA_MAX                                        INT_MAX
 
 #define CMK_CONVERSE_MPI                                   0
+
+#define CMK_MSGALLOC_AVAILABLE                             1
+
+#define CMK_LARGE_MSG_AVAILABLE                            1
@@ -7,6 +7,12 @@
 #define CMIQueueCreate  LRTSQueueCreate
 #define CMIQueuePop     LRTSQueuePop
 #define CMIQueueEmpty   LRTSQueueEmpty
+#elif CMK_PCQUEUE_MPSC && CMK_SMP
+#define CMIQueue MPSCPCQueue
+#define CMIQueuePush    MPSCPCQueuePush
+#define CMIQueueCreate  MPSCPCQueueCreate
+#define CMIQueuePop     MPSCPCQueuePop
+#define CMIQueueEmpty   MPSCPCQueueEmpty
 #else
 #define CMIQueue PCQueue
 #define CMIQueuePush    PCQueuePush
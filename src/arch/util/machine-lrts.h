@@ -3,14 +3,14 @@
 
 #include "converse.h"
 
-void LrtsPrepareEnvelope(char *msg, int size);
+void LrtsPrepareEnvelope(char *msg, size_t size);
 
 /* The machine-specific send function */
-CmiCommHandle LrtsSendFunc(int destNode, int destPE, int size, char *msg, int mode);
+CmiCommHandle LrtsSendFunc(int destNode, int destPE, size_t size, char *msg, int mode);
 
-void LrtsSyncListSendFn(int npes, const int *pes, int len, char *msg);
-CmiCommHandle LrtsAsyncListSendFn(int npes, const int *pes, int len, char *msg);
-void LrtsFreeListSendFn(int npes, const int *pes, int len, char *msg);
+void LrtsSyncListSendFn(int npes, const int *pes, size_t len, char *msg);
+CmiCommHandle LrtsAsyncListSendFn(int npes, const int *pes, size_t len, char *msg);
+void LrtsFreeListSendFn(int npes, const int *pes, size_t len, char *msg);
 
 #if CMK_PERSISTENT_COMM
 void LrtsSendPersistentMsg(PersistentHandle h, int destPE, int size, void *m);
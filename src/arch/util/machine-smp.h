@@ -31,6 +31,21 @@ typedef struct {
   HANDLE sem;
 } CmiIdleLock;
 
+#elif CMK_SHARED_VARS_POSIX_THREADS_SMP && defined(__linux__)
+
+/* Idle PEs park on a futex on their state word, which pushes to the PE
+   set with a single atomic exchange */
+#define CMK_IDLE_FUTEX 1
+#include <atomic>
+
+#define CMI_IDLE_EMPTY   0 /* No message arrived since the last check */
+#define CMI_IDLE_MESSAGE 1 /* A message arrived since the last check */
+#define CMI_IDLE_PARKED  2 /* The PE is asleep on the futex */
+
+typedef struct {
+  std::atomic<int> state; /* One of CMI_IDLE_*, also the futex word */
+} CmiIdleLock;
+
 #elif CMK_SHARED_VARS_POSIX_THREADS_SMP
 
 typedef struct {
@@ -66,6 +81,34 @@ typedef struct {
 #endif
 #endif
 
+#if CMK_SMP
+/************************************************************
+ *
+ * Within-node broadcast ring
+ *   A message that each of the other ranks of a node must get a
+ * copy of is copied once into this ring, and a pointer to its slot
+ * is pushed into each rank's receive queue. Each rank then makes
+ * its own copy when it pops the slot, in order with the messages
+ * it was sent point to point, instead of the sender making them.
+ *
+ ************************************************************/
+#include <atomic>
+
+#define CMI_BCAST_RING_SIZE 256
+
+typedef struct {
+  std::atomic<CmiUInt8> seq; /* Position the slot is free for, that plus one once published */
+  char *msg;                 /* A private copy of the message */
+  size_t size;
+  std::atomic<int> pending;  /* Ranks yet to pass the slot */
+} CmiBcastSlot;
+
+typedef struct {
+  std::atomic<CmiUInt8> head; /* Position of the next slot to publish */
+  CmiBcastSlot slots[CMI_BCAST_RING_SIZE];
+} CmiBcastRing;
+#endif
+
 /************************************************************
  *
  * Processor state structure
@@ -104,6 +147,9 @@ typedef struct CmiNodeStateStruct
   CMIQueue     NodeRecv;
 #endif
 #endif
+#if CMK_SMP
+  CmiBcastRing *bcastRing;
+#endif
 }
 CmiNodeState;
 
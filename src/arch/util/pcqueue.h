@@ -396,6 +396,179 @@ static void PCQueuePush(PCQueue Q, char *data)
 }
 #endif
 
+// CMK_PCQUEUE_MPSC (disabled by default, enable with --enable-mpsc-pcqueue)
+#if CMK_SMP && CMK_PCQUEUE_MPSC
+
+/*
+ * Lock-free multi-producer, single-consumer queue used for the CMIQueue
+ * queues (PE receive queues, node queue, broadcast and immediate queues).
+ *
+ * Every rank of the node (and the comm thread) owns a lane, which is an
+ * unbounded single-producer chain of blocks in the same style as the
+ * CircQueue above. A push only touches the pushing rank's lane and the shared
+ * length counter, so no lock is taken. Threads without a rank of this node
+ * share one extra lane, which keeps a lock around the push.
+ *
+ * The consumer visits the lanes round-robin, taking up to MPSCPCQueueBatch
+ * messages from a lane before moving on, so messages from one producer stay
+ * in FIFO order but messages from different producers may be reordered.
+ * Pops from several threads must be serialized by the caller, as for PCQueue.
+ */
+
+#define MPSCPCQueueBatch 64
+
+int CmiMyStateRank(void); /* machine-smp.C */
+
+typedef struct MPSCLaneBlockStruct
+{
+  struct MPSCLaneBlockStruct *next; /* linked in before the last slot is filled */
+  std::atomic<char *> data[PCQueueSize];
+}
+*MPSCLaneBlock;
+
+typedef struct MPSCLaneStruct
+{
+  /* Consumer side; head stays NULL until the producer's first push */
+  CMK_SMP_align std::atomic<MPSCLaneBlock> head;
+  int pull;
+  /* Producer side */
+  CMK_SMP_align MPSCLaneBlock tail;
+  int push;
+}
+*MPSCLane;
+
+typedef struct MPSCPCQueueStruct
+{
+  CMK_SMP_align std::atomic<int> len;
+  /* Consumer-only state */
+  CMK_SMP_align int cursor;
+  int served; /* messages taken from lanes[cursor] since the consumer moved to it */
+  int numLanes;
+  MPSCLane lanes;
+  CmiNodeLock sharedLock; /* guards pushes into the last lane */
+}
+*MPSCPCQueue;
+
+static MPSCPCQueue MPSCPCQueueCreate(void)
+{
+  MPSCPCQueue Q = (MPSCPCQueue)malloc(sizeof(struct MPSCPCQueueStruct));
+  _MEMCHECK(Q);
+  /* One lane per rank and one for the comm thread, plus the shared lane */
+  Q->numLanes = CmiMyNodeSize() + 2;
+  Q->lanes = (MPSCLane)calloc(Q->numLanes, sizeof(struct MPSCLaneStruct));
+  _MEMCHECK(Q->lanes);
+  std::atomic_store_explicit(&Q->len, 0, std::memory_order_relaxed);
+  Q->cursor = 0;
+  Q->served = 0;
+  Q->sharedLock = CmiCreateLock();
+  return Q;
+}
+
+static void MPSCPCQueueDestroy(MPSCPCQueue Q)
+{
+  int i;
+  for (i = 0; i < Q->numLanes; i++) {
+    MPSCLaneBlock blk = std::atomic_load_explicit(&Q->lanes[i].head, std::memory_order_relaxed);
+    while (blk != NULL) {
+      MPSCLaneBlock next = blk->next;
+      free(blk);
+      blk = next;
+    }
+  }
+  CmiDestroyLock(Q->sharedLock);
+  free(Q->lanes);
+  free(Q);
+}
+
+static int MPSCPCQueueEmpty(MPSCPCQueue Q)
+{
+  return (std::atomic_load_explicit(&Q->len, std::memory_order_acquire) == 0);
+}
+
+static int MPSCPCQueueLength(MPSCPCQueue Q)
+{
+  return std::atomic_load_explicit(&Q->len, std::memory_order_acquire);
+}
+
+static void MPSCLanePush(MPSCLane lane, char *data)
+{
+  MPSCLaneBlock blk = lane->tail;
+  int push = lane->push;
+
+  if (blk == NULL) { /* first push into this lane */
+    blk = (MPSCLaneBlock)calloc(1, sizeof(struct MPSCLaneBlockStruct));
+    _MEMCHECK(blk);
+    lane->tail = blk;
+    std::atomic_store_explicit(&lane->head, blk, std::memory_order_release);
+  }
+
+  if (push == PCQueueSize - 1) { /* last slot is about to be filled */
+    MPSCLaneBlock next = (MPSCLaneBlock)calloc(1, sizeof(struct MPSCLaneBlockStruct));
+    _MEMCHECK(next);
+    blk->next = next; /* published by the release store of the last slot */
+    lane->tail = next;
+    lane->push = 0;
+  } else {
+    lane->push = push + 1;
+  }
+  std::atomic_store_explicit(&blk->data[push], data, std::memory_order_release);
+}
+
+static char *MPSCLanePop(MPSCLane lane)
+{
+  MPSCLaneBlock blk = std::atomic_load_explicit(&lane->head, std::memory_order_acquire);
+  if (blk == NULL) return 0;
+
+  int pull = lane->pull;
+  char *data = std::atomic_load_explicit(&blk->data[pull], std::memory_order_acquire);
+  if (data == NULL) return 0; /* empty, or the producer is still filling this slot */
+
+  if (pull == PCQueueSize - 1) { /* just pulled the data from the last slot of this block */
+    std::atomic_store_explicit(&lane->head, blk->next, std::memory_order_relaxed);
+    lane->pull = 0;
+    free(blk);
+  } else {
+    lane->pull = pull + 1;
+  }
+  return data;
+}
+
+static void MPSCPCQueuePush(MPSCPCQueue Q, char *data)
+{
+  int rank = CmiMyStateRank();
+  if (rank >= 0 && rank < Q->numLanes - 1) {
+    MPSCLanePush(&Q->lanes[rank], data);
+  } else {
+    CmiLock(Q->sharedLock);
+    MPSCLanePush(&Q->lanes[Q->numLanes - 1], data);
+    CmiUnlock(Q->sharedLock);
+  }
+  std::atomic_fetch_add_explicit(&Q->len, 1, std::memory_order_release);
+}
+
+static char *MPSCPCQueuePop(MPSCPCQueue Q)
+{
+  int i;
+  if (std::atomic_load_explicit(&Q->len, std::memory_order_relaxed) == 0) return 0;
+
+  for (i = 0; i < Q->numLanes; i++) {
+    char *data = MPSCLanePop(&Q->lanes[Q->cursor]);
+    if (data != NULL) {
+      if (++Q->served == MPSCPCQueueBatch) {
+        Q->served = 0;
+        if (++Q->cursor == Q->numLanes) Q->cursor = 0;
+      }
+      std::atomic_fetch_sub_explicit(&Q->len, 1, std::memory_order_release);
+      return data;
+    }
+    Q->served = 0;
+    if (++Q->cursor == Q->numLanes) Q->cursor = 0;
+  }
+  return 0;
+}
+
+#endif /* CMK_SMP && CMK_PCQUEUE_MPSC */
+
 // CMK_LOCKLESS_QUEUE (disabled by default)
 #if CMK_LOCKLESS_QUEUE
 
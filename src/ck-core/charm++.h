@@ -1165,10 +1165,10 @@ private:
 
 class CkQdMsg {
   public:
-    void *operator new(size_t s) { return CkAllocMsg(0,(int)s,0,GroupDepNum{}); }
+    void *operator new(size_t s) { return CkAllocMsg(0,s,0,GroupDepNum{}); }
     void operator delete(void* ptr) { CkFreeMsg(ptr); }
     static void *alloc(int, size_t s, int*, int, int) {
-      return CkAllocMsg(0,(int)s,0,GroupDepNum{});
+      return CkAllocMsg(0,s,0,GroupDepNum{});
     }
     static void *pack(CkQdMsg *m) { return (void*) m; }
     static CkQdMsg *unpack(void *buf) { return (CkQdMsg*) buf; }
@@ -1229,6 +1229,7 @@ if(CpvAccess(networkProgressCount) >=  p)  \
 #include "envelope.h"
 #include "pathHistory.h"
 #include "ckcallback-ccs.h"
+#include "ckcoroutine.h"
 
 
 template<typename... tArgs>
@@ -106,7 +106,7 @@ struct GroupDepNum
   operator int() const { return groupDepNum; }
 };
 #endif
-extern void* CkAllocMsg(int msgIdx, int msgBytes, int prioBits, GroupDepNum groupDepNum=GroupDepNum{});
+extern void* CkAllocMsg(int msgIdx, size_t msgBytes, int prioBits, GroupDepNum groupDepNum=GroupDepNum{});
 #endif
 extern void  CkFreeSysMsg(void *msg);
 extern void* CkAllocBuffer(void *msg, int bufsize);
@@ -188,8 +188,8 @@ inline void _CldNodeEnqueue(int node, void *msg, int infofn) {
 CkpvExtern(std::vector<void *>, chare_objs);
 #endif
 
-#include <unordered_map>
-typedef std::unordered_map<CmiUInt8, ArrayElement*> ArrayObjMap;
+#include "ckflathashmap.h"
+typedef ck::FlatHashMap<CmiUInt8, ArrayElement*> ArrayObjMap;
 CkpvExtern(ArrayObjMap, array_objs);
 
 /// A set of "Virtual ChareID"'s
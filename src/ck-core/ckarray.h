@@ -390,6 +390,11 @@ public:
 #endif
   // for _PIPELINED_ALLREDUCE_, assembler entry method
   inline void defrag(CkReductionMsg* msg);
+  // for ck::reduction_awaiter (see ckcoroutine.h): results of reductions sent to
+  // ckReductionResumeCallback() are passed, in order, to the functions queued here
+  void ckAwaitReduction(CkCallbackFn fn, void* param);
+  CkCallback ckReductionResumeCallback(void) const;
+  void ckResumeReduction(CkReductionMsg* msg);
   inline const CkArrayID& ckGetArrayID(void) const { return thisArrayID; }
   inline ck::ObjID ckGetID(void) const { return ck::ObjID(thisArrayID, myRec->getID()); }
 
@@ -639,7 +644,7 @@ class CkArray : public CkReductionMgr
   friend class CProxyElement_ArrayBase;
   friend class CkLocMgr;
 
-  using IDMsgBuffer = std::unordered_map<CmiUInt8, std::vector<CkArrayMessage*> >;
+  using IDMsgBuffer = ck::FlatHashMap<CmiUInt8, std::vector<CkArrayMessage*> >;
   using IndexMsgBuffer
       = std::unordered_map<CkArrayIndex, std::vector<CkArrayMessage*>, IndexHasher>;
   IDMsgBuffer bufferedIDMsgs;
@@ -656,7 +661,7 @@ class CkArray : public CkReductionMgr
   CkCallback initCallback;
   CProxy_CkArray thisProxy;
   // Separate mapping and storing the element pointers to speed iteration in broadcast
-  std::unordered_map<CmiUInt8, unsigned int> localElems;
+  ck::FlatHashMap<CmiUInt8, unsigned int> localElems;
   std::vector<CkMigratable*> localElemVec;
 
   UShort recvBroadcastEpIdx;
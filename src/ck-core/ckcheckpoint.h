@@ -76,6 +76,11 @@ extern bool _restarted;          // 1: if this run is after restart
 extern int _oldNumPes;           // number of processors in the last run
 extern bool _chareRestored;      // 1: if chare is restored at restart
 
+// options for the aggregated disk checkpoint format
+extern int _chkptFilesPerNode;   // files written by each node, 0: files per PE
+extern bool _chkptCompress;      // LZ4-compress the checkpoint data
+extern size_t _chkptBlockSize;   // bytes per compressed block and per write
+
 enum{CK_CHECKPOINT_SUCCESS, CK_CHECKPOINT_FAILURE};
 
 class CkCheckpointStatusMsg:public CMessage_CkCheckpointStatusMsg{
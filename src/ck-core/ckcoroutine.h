@@ -0,0 +1,196 @@
+/*
+Stackless C++20 coroutine entry methods.
+
+An entry method declared [coroutine] in the .ci file returns a ck::coroutine
+and may co_await on futures, callbacks, reductions and zero-copy
+completions. A suspended entry method keeps only its coroutine frame alive;
+it gives the PE back to the scheduler, and is resumed from the scheduler
+queue once the awaited event arrives, like any other message.
+
+Everything below needs a C++20 compiler (e.g. charmc -std=c++20); with an
+older standard this header declares nothing.
+*/
+#ifndef _CKCOROUTINE_H_
+#define _CKCOROUTINE_H_
+
+#include "charm++.h"
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define CK_HAS_COROUTINES 1
+#endif
+#endif
+
+#if CK_HAS_COROUTINES
+#include <coroutine>
+#include <utility>
+
+namespace ck {
+
+namespace detail {
+  inline void resumeCoroutine(void *frame) {
+    std::coroutine_handle<>::from_address(frame).resume();
+  }
+
+  // Resume a suspended coroutine from this PE's scheduler queue rather than from
+  // the stack of whatever delivered the event it was waiting for
+  inline void resumeLater(std::coroutine_handle<> h) {
+    CkEnqueueResume(resumeCoroutine, h.address());
+  }
+}
+
+/**
+ * Return type of a [coroutine] entry method. The coroutine starts running as
+ * soon as the entry method is invoked; once it has suspended, the frame owns
+ * itself and is destroyed when the coroutine finishes.
+ */
+class coroutine {
+ public:
+  struct promise_type {
+    void *msg = nullptr;    // Marshalled message the arguments were unpacked from
+    bool detached = false;  // No ck::coroutine object refers to the frame any more
+
+    ~promise_type() {
+      if (msg) CkFreeMsg(msg);
+    }
+
+    coroutine get_return_object() {
+      return coroutine(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+
+    struct final_awaiter {
+      bool await_ready() noexcept { return false; }
+      // Stay suspended (so the owner can see we are done) unless nobody owns the frame
+      bool await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+        return !h.promise().detached;
+      }
+      void await_resume() noexcept {}
+    };
+    final_awaiter final_suspend() noexcept { return {}; }
+
+    void return_void() {}
+    void unhandled_exception() {
+      CkAbort("Unhandled exception escaped a [coroutine] entry method");
+    }
+  };
+
+  coroutine(coroutine &&o) noexcept : h(std::exchange(o.h, nullptr)) {}
+  coroutine(const coroutine &) = delete;
+  coroutine &operator=(const coroutine &) = delete;
+
+  ~coroutine() {
+    if (!h) return;
+    if (h.done())
+      h.destroy();
+    else
+      h.promise().detached = true;
+  }
+
+  bool done() const { return !h || h.done(); }
+
+  /// Keep the message the arguments point into until the coroutine finishes.
+  /// The generated code calls this for parameter-marshalled entry methods.
+  void adoptMessage(void *msg) {
+    if (done())
+      CkFreeMsg(msg);
+    else
+      h.promise().msg = msg;
+  }
+
+ private:
+  explicit coroutine(std::coroutine_handle<promise_type> h_) : h(h_) {}
+  std::coroutine_handle<promise_type> h;
+};
+
+/// co_await on a local future suspends until it has a value, then returns it
+template <typename T>
+auto operator co_await(const future<T> &f) {
+  struct awaiter {
+    future<T> f;
+    bool await_ready() {
+      if (!f.is_local()) reject_non_local();
+      return f.is_ready();
+    }
+    void await_suspend(std::coroutine_handle<> h) {
+      CkResumeOnFutureID(f.handle().id, detail::resumeCoroutine, h.address());
+    }
+    T await_resume() { return f.get(); }
+  };
+  return awaiter{f};
+}
+
+/**
+ * A one-shot CkCallback that a coroutine can co_await. Pass it (it converts to
+ * a CkCallback) wherever a callback is expected, then co_await it to suspend
+ * until the message arrives:
+ *
+ *   ck::callback_awaiter<CkDataMsg> done;
+ *   CkNcpyBuffer src(buf, size, done);
+ *   ...
+ *   CkDataMsg *m = co_await done;
+ *
+ * Like CkCallbackResumeThread, only the one coroutine that made the awaiter
+ * is resumed. The awaiter must stay alive until the callback has been sent,
+ * which it does when it is a local variable of the coroutine. The callback may
+ * be sent from any PE; the coroutine resumes on the PE that made the awaiter.
+ */
+template <typename MsgType = CkMessage>
+class callback_awaiter {
+  void *msg = nullptr;
+  bool arrived = false;
+  std::coroutine_handle<> waiter;
+
+ protected:
+  CkCallback cb;
+
+  static void arrive(void *param, void *m) {
+    callback_awaiter *self = static_cast<callback_awaiter *>(param);
+    if (self->arrived) CkAbort("A ck::callback_awaiter was sent more than once");
+    self->msg = m;
+    self->arrived = true;
+    if (self->waiter) detail::resumeLater(self->waiter);
+  }
+
+ public:
+  callback_awaiter() : cb(arrive, this) {}
+  callback_awaiter(const callback_awaiter &) = delete;
+  callback_awaiter &operator=(const callback_awaiter &) = delete;
+
+  CkCallback &callback() { return cb; }
+  operator CkCallback &() { return cb; }
+
+  bool await_ready() const { return arrived; }
+  void await_suspend(std::coroutine_handle<> h) { waiter = h; }
+  MsgType *await_resume() { return static_cast<MsgType *>(msg); }
+};
+
+/**
+ * Awaits the result of a reduction. Made with the contributing array element,
+ * the result is broadcast back and every contributor that awaits it resumes
+ * with its own copy; made without one, it behaves as a callback_awaiter.
+ *
+ *   ck::reduction_awaiter sum(this);
+ *   contribute(sizeof(x), &x, CkReduction::sum_double, sum);
+ *   CkReductionMsg *m = co_await sum;
+ *
+ * An element must not migrate while it awaits a reduction.
+ */
+class reduction_awaiter : public callback_awaiter<CkReductionMsg> {
+ public:
+  reduction_awaiter() = default;
+  explicit reduction_awaiter(ArrayElement *elem) {
+    elem->ckAwaitReduction(arrive, this);
+    cb = elem->ckReductionResumeCallback();
+  }
+};
+
+/// Awaits a zero-copy source or destination completion; the completed
+/// CkNcpyBuffer is in the message's data field
+using zerocopy_awaiter = callback_awaiter<CkDataMsg>;
+
+}  // namespace ck
+
+#endif  // CK_HAS_COROUTINES
+
+#endif  // _CKCOROUTINE_H_
@@ -58,6 +58,12 @@ void* CkGetMsgBuffer(void* msg);
 std::vector<void*> CkWaitAllIDs(const std::vector<CkFutureID>& handles);
 std::pair<void*, CkFutureID> CkWaitAnyID(const std::vector<CkFutureID>& handles);
 
+// Used by coroutine entry methods (see ckcoroutine.h) instead of blocking a thread:
+// enqueue a call of fn(arg) on this PE's scheduler queue, right away or once the
+// future has a value
+void CkEnqueueResume(void (*fn)(void*), void* arg);
+void CkResumeOnFutureID(CkFutureID handle, void (*fn)(void*), void* arg);
+
 namespace ck {
 namespace {
   void reject_non_local() {
@@ -10,6 +10,7 @@ array proxies, or the details of element creation (see ckarray.h).
 #define __CKLOCATION_H
 
 #include <unordered_map>
+#include "ckflathashmap.h"
 struct IndexHasher
 {
 public:
@@ -330,7 +331,7 @@ class CkLocCache : public CBase_CkLocCache
 {
 private:
   // Map of ID to PE
-  using LocationMap = std::unordered_map<CmiUInt8, CkLocEntry>;
+  using LocationMap = ck::FlatHashMap<CmiUInt8, CkLocEntry>;
   LocationMap locMap;
 
   using Listener = std::function<void(CmiUInt8, int)>;
@@ -390,12 +391,12 @@ private:
   friend class MemElementPacker;
 
   using ArrayIdMap = std::unordered_map<CkArrayID, CkArray*, ArrayIDHasher>;
-  using MsgBuffer = std::unordered_map<CmiUInt8, std::vector<CkArrayMessage*> >;
+  using MsgBuffer = ck::FlatHashMap<CmiUInt8, std::vector<CkArrayMessage*> >;
   using LocationRequestBuffer =
       std::unordered_map<CkArrayIndex, std::vector<int>, IndexHasher>;
   using IdxIdMap = std::unordered_map<CkArrayIndex, CmiUInt8, IndexHasher>;
-  using LocRecHash = std::unordered_map<CmiUInt8, CkLocRec*>;
-  using ElemMap = std::unordered_map<CmiUInt8, CkMigratable*>;
+  using LocRecHash = ck::FlatHashMap<CmiUInt8, CkLocRec*>;
+  using ElemMap = ck::FlatHashMap<CmiUInt8, CkMigratable*>;
 
   using LocationListener = std::function<void(CmiUInt8, int)>;
   using IndexListener = std::function<void(const CkArrayIndex&, CmiUInt8, int)>;
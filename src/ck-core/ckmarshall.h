@@ -1,6 +1,9 @@
 #ifndef _CKMARSHALL_H_
 #define _CKMARSHALL_H_
 
+#include <string.h>
+#include <vector>
+
 #include "charm++.h"
 #include "CkMarshall.decl.h"
 
@@ -10,27 +13,146 @@ public:
   char *msgBuf;
 };
 
-CkMarshallMsg *CkAllocateMarshallMsgNoninline(int size, const CkEntryOptions *opts);
+/// Allocate a marshall message of type T whose msgBuf holds size bytes. This
+/// lays the message out the way the generated varsize allocator does, but the
+/// generated one counts msgBuf in ints, which would cap parameters at 2 GB.
+template <typename T>
+inline T *CkAllocateMarshallMsgSized(size_t size, int priobits, GroupDepNum groupDepNum) {
+  CkpvAccess(_offsets)[0] = ALIGN_DEFAULT(sizeof(T));
+  void *buf = CkAllocMsg(T::__idx, CkpvAccess(_offsets)[0] + ALIGN_DEFAULT(size),
+                         priobits, groupDepNum);
+  T *m = new (buf) T;
+  setMemoryTypeMessage(UsrToEnv(m));
+  return m;
+}
+
+/* Marshalled parameters are stored one after another in msgBuf, each at a
+   running offset the generated code keeps in a size_t. Parameters that PUP
+   would copy as plain bytes anyway (builtin types and PUPbytes types), and
+   std::vectors of those, are stored at their natural alignment and copied with
+   memcpy: the sender works out the message size in closed form, and the
+   receiver reads scalars in place instead of copying them out. Any other
+   parameter is PUP'd at its offset. */
+
+/// True if a parameter of type T is marshalled as plain bytes
+template <typename T>
+struct CkMarshallIsFlat
+    : std::integral_constant<bool, PUP::as_bytes<T>::value && (alignof(T) <= ALIGN_BYTES)> {};
+
+template <typename T, typename Enable = void>
+struct CkMarshallParam {
+  static void size(size_t &pos, const T &t) {
+    PUP::sizer p;
+    p | const_cast<T &>(t);
+    pos += p.size();
+  }
+  static void pack(char *buf, size_t &pos, const T &t) {
+    PUP::toMem p((void *)(buf + pos));
+    p | const_cast<T &>(t);
+    pos += p.size();
+  }
+  static void unpack(char *buf, size_t &pos, T &t) {
+    PUP::fromMem p((void *)(buf + pos));
+    p | t;
+    pos += p.size();
+  }
+};
+
+template <typename T>
+struct CkMarshallParam<T, typename std::enable_if<CkMarshallIsFlat<T>::value>::type> {
+  static void size(size_t &pos, const T &) { pos = CK_ALIGN(pos, alignof(T)) + sizeof(T); }
+  static void pack(char *buf, size_t &pos, const T &t) {
+    pos = CK_ALIGN(pos, alignof(T));
+    memcpy(buf + pos, &t, sizeof(T));
+    pos += sizeof(T);
+  }
+  static T &get(char *buf, size_t &pos) {
+    pos = CK_ALIGN(pos, alignof(T));
+    T *t = reinterpret_cast<T *>(buf + pos);
+    pos += sizeof(T);
+    return *t;
+  }
+  static void unpack(char *buf, size_t &pos, T &t) { t = get(buf, pos); }
+};
+
+// A vector is stored as its length followed by its elements
+template <typename T, typename A>
+struct CkMarshallParam<std::vector<T, A>,
+                       typename std::enable_if<CkMarshallIsFlat<T>::value &&
+                                               !std::is_same<T, bool>::value>::type> {
+  static void size(size_t &pos, const std::vector<T, A> &v) {
+    pos = CK_ALIGN(CK_ALIGN(pos, alignof(size_t)) + sizeof(size_t), alignof(T));
+    pos += v.size() * sizeof(T);
+  }
+  static void pack(char *buf, size_t &pos, const std::vector<T, A> &v) {
+    CkMarshallParam<size_t>::pack(buf, pos, v.size());
+    pos = CK_ALIGN(pos, alignof(T));
+    if (!v.empty()) memcpy(buf + pos, v.data(), v.size() * sizeof(T));
+    pos += v.size() * sizeof(T);
+  }
+  static void unpack(char *buf, size_t &pos, std::vector<T, A> &v) {
+    size_t n = CkMarshallParam<size_t>::get(buf, pos);
+    pos = CK_ALIGN(pos, alignof(T));
+    const T *data = reinterpret_cast<const T *>(buf + pos);
+    v.assign(data, data + n);
+    pos += n * sizeof(T);
+  }
+};
+
+template <typename T>
+using CkMarshallType = typename std::remove_cv<typename std::remove_reference<T>::type>::type;
+
+template <typename T>
+inline void CkMarshallSize(size_t &pos, const T &t) {
+  CkMarshallParam<CkMarshallType<T>>::size(pos, t);
+}
+template <typename T>
+inline void CkMarshallPack(char *buf, size_t &pos, const T &t) {
+  CkMarshallParam<CkMarshallType<T>>::pack(buf, pos, t);
+}
+template <typename T>
+inline void CkMarshallUnpack(char *buf, size_t &pos, T &t) {
+  CkMarshallParam<CkMarshallType<T>>::unpack(buf, pos, t);
+}
+
+/// Holds a parameter unmarshalled on the receiver as member t: a reference
+/// into the message for flat types, an unpacked copy for everything else
+template <typename T, typename Enable = void>
+struct CkMarshallUnpacked : PUP::detail::TemporaryObjectHolder<T> {
+  CkMarshallUnpacked(char *buf, size_t &pos) { CkMarshallUnpack(buf, pos, this->t); }
+};
+
+template <typename T>
+struct CkMarshallUnpacked<T, typename std::enable_if<
+                                 CkMarshallIsFlat<CkMarshallType<T>>::value>::type> {
+  CkMarshallType<T> &t;
+  CkMarshallUnpacked(char *buf, size_t &pos)
+      : t(CkMarshallParam<CkMarshallType<T>>::get(buf, pos)) {}
+};
+
+template <typename T>
+inline void operator|(PUP::er &p, CkMarshallUnpacked<T> &u) {
+  p | u.t;
+}
+
+CkMarshallMsg *CkAllocateMarshallMsgNoninline(size_t size, const CkEntryOptions *opts);
 
-inline CkMarshallMsg *CkAllocateMarshallMsg(int size, const CkEntryOptions *opts = NULL) {
-  if (opts == NULL) {
-    CkMarshallMsg *newMemory = new (size, 0) CkMarshallMsg;
-    setMemoryTypeMessage(UsrToEnv(newMemory));
-    return newMemory;
-  } else
+inline CkMarshallMsg *CkAllocateMarshallMsg(size_t size, const CkEntryOptions *opts = NULL) {
+  if (opts == NULL)
+    return CkAllocateMarshallMsgSized<CkMarshallMsg>(size, 0, GroupDepNum{});
+  else
     return CkAllocateMarshallMsgNoninline(size, opts);
 }
 
 template <typename T>
-inline T *CkAllocateMarshallMsgT(int size, const CkEntryOptions *opts) {
+inline T *CkAllocateMarshallMsgT(size_t size, const CkEntryOptions *opts) {
   int priobits = 0;
   if (opts != NULL)
     priobits = opts->getPriorityBits();
   // Allocate the message
-  T *m = new (size, priobits) T;
+  T *m = CkAllocateMarshallMsgSized<T>(size, priobits, GroupDepNum{});
   // Copy the user's priority data into the message
   envelope *env = UsrToEnv(m);
-  setMemoryTypeMessage(env);
   if (opts != NULL) {
     CmiMemcpy(env->getPrioPtr(), opts->getPriorityPtr(), env->getPrioBytes());
     // Set the message's queueing type
@@ -25,6 +25,10 @@ The calls needed to use the reduction manager are:
 #define FRAG_THRESHOLD 131072
 #endif
 
+// Most segments a contribution is split into with +reductionSegmentSize, limited
+// by the width of CkReductionMsg::nFrags
+#define CK_REDUCTION_MAX_SEGMENTS 127
+
 
 //This message is sent between group objects on a single PE
 // to let each know the other has been created.
@@ -266,11 +270,53 @@ private:
     // so it is not a standalone function in ckreduction.C like other reduction implementations
     static CkReductionMsg* tupleReduction_fn(int nMsgs, CkReductionMsg** msgs);
 
+    // Whether the reducer combines contributions element by element, so that any
+    // piece of the result can be computed from the same piece of each contribution
+    static bool isElementwise(reducerType r) { return r>=sum_char && r<=bitvec_xor_bool; }
+
 	//Don't instantiate a CkReduction object-- it's just a namespace.
 	CkReduction();
 };
 PUPbytes(CkReduction::reducerType)
 
+/* Element-wise kernels behind the built-in sum, product, max, min, logical and
+   bitvec reducers. Each one folds the nIn arrays in[0..nIn-1] into ret, in that
+   order, with a single pass over ret. They are also usable directly on plain
+   buffers, e.g. by libraries that combine contributions outside of a reducer. */
+#define CK_REDUCE_KERNEL_DECL(name,dataType) \
+  void name(dataType *ret, const dataType * const *in, int nIn, size_t n);
+#define CK_REDUCE_POLYMORPH_KERNEL_DECL(name) \
+  CK_REDUCE_KERNEL_DECL(name,char) \
+  CK_REDUCE_KERNEL_DECL(name,short) \
+  CK_REDUCE_KERNEL_DECL(name,int) \
+  CK_REDUCE_KERNEL_DECL(name,long) \
+  CK_REDUCE_KERNEL_DECL(name,long long) \
+  CK_REDUCE_KERNEL_DECL(name,unsigned char) \
+  CK_REDUCE_KERNEL_DECL(name,unsigned short) \
+  CK_REDUCE_KERNEL_DECL(name,unsigned int) \
+  CK_REDUCE_KERNEL_DECL(name,unsigned long) \
+  CK_REDUCE_KERNEL_DECL(name,unsigned long long) \
+  CK_REDUCE_KERNEL_DECL(name,float) \
+  CK_REDUCE_KERNEL_DECL(name,double)
+
+CK_REDUCE_POLYMORPH_KERNEL_DECL(CkReduceSum)
+CK_REDUCE_POLYMORPH_KERNEL_DECL(CkReduceProduct)
+CK_REDUCE_POLYMORPH_KERNEL_DECL(CkReduceMax)
+CK_REDUCE_POLYMORPH_KERNEL_DECL(CkReduceMin)
+// Logical kernels on ints store 0 or 1
+CK_REDUCE_KERNEL_DECL(CkReduceLogicalAnd,int)
+CK_REDUCE_KERNEL_DECL(CkReduceLogicalAnd,bool)
+CK_REDUCE_KERNEL_DECL(CkReduceLogicalOr,int)
+CK_REDUCE_KERNEL_DECL(CkReduceLogicalOr,bool)
+CK_REDUCE_KERNEL_DECL(CkReduceLogicalXor,int)
+CK_REDUCE_KERNEL_DECL(CkReduceLogicalXor,bool)
+CK_REDUCE_KERNEL_DECL(CkReduceBitAnd,int)
+CK_REDUCE_KERNEL_DECL(CkReduceBitAnd,bool)
+CK_REDUCE_KERNEL_DECL(CkReduceBitOr,int)
+CK_REDUCE_KERNEL_DECL(CkReduceBitOr,bool)
+CK_REDUCE_KERNEL_DECL(CkReduceBitXor,int)
+CK_REDUCE_KERNEL_DECL(CkReduceBitXor,bool)
+
 #if CMK_CHARM4PY
 //CkReductionTypesExt struct to expose the reducerTypes for external
 //modules like Charm4py
@@ -698,9 +744,14 @@ private:
 	CkMsgQ<CkReductionMsg> finalMsgs;
       std::unordered_map<int, int> inactiveList;
 
+	//At the root, the segments of a split contribution reduced so far
+	CkReductionMsg *segmentedResult;
+
 //State:
 	void startReduction(int number,int srcPE);
 	void addContribution(CkReductionMsg *m);
+	void contributeSegments(contributorInfo *ci,CkReductionMsg *m);
+	CkReductionMsg *assembleSegment(CkReductionMsg *m);
 	void finishReduction(void);
   void checkIsActive();
   void informParentInactive();
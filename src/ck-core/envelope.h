@@ -191,7 +191,7 @@ namespace ck {
   char   core[CmiReservedHeaderSize];                                          \
   UInt   pe;           /* source processor */                                  \
   ck::impl::u_type type; /* Depends on message type (attribs.mtype) */         \
-  UInt   totalsize;    /* Byte count from envelope start to end of group dependencies */ \
+  CmiUInt8 totalsize;  /* Byte count from envelope start to end of group dependencies */ \
   CMK_ENVELOPE_OPTIONAL_FIELDS                                                 \
   CMK_REFNUM_TYPE ref; /* Used by futures and SDAG */                          \
   UShort priobits;     /* Number of bits of priority data after user data */   \
@@ -252,18 +252,18 @@ public:
 #endif
     UChar  getMsgIdx(void) const { return attribs.msgIdx; }
     void   setMsgIdx(const UChar idx) { attribs.msgIdx = idx; }
-    UInt   getTotalsize(void) const { return totalsize; }
-    void   setTotalsize(const UInt s) { totalsize = s; }
-    UInt   getUsersize(void) const { 
+    size_t getTotalsize(void) const { return totalsize; }
+    void   setTotalsize(const size_t s) { totalsize = s; }
+    size_t getUsersize(void) const { 
       return totalsize - getGroupDepSize() - getPrioBytes() - sizeof(envelope); 
     }
-    void   setUsersize(const UInt s) {
+    void   setUsersize(const size_t s) {
       if (s == getUsersize()) {
         return;
       }
       CkAssert(s < getUsersize());
-      UInt newPrioOffset = sizeof(envelope) + CkMsgAlignLength(s);
-      UInt newTotalsize = newPrioOffset + getPrioBytes() + getGroupDepSize();
+      size_t newPrioOffset = sizeof(envelope) + CkMsgAlignLength(s);
+      size_t newTotalsize = newPrioOffset + getPrioBytes() + getGroupDepSize();
       void *newPrioPtr = (void *) ((char *) this + newPrioOffset); 
       // use memmove instead of memcpy in case memory areas overlap
       memmove(newPrioPtr, getPrioPtr(), getPrioBytes()); 
@@ -271,7 +271,7 @@ public:
     }
 
     // s specifies number of bytes to remove from user portion of message
-    void shrinkUsersize(const UInt s) {
+    void shrinkUsersize(const size_t s) {
       CkAssert(s <= getUsersize());
       setUsersize(getUsersize() - s);
     }
@@ -290,7 +290,7 @@ public:
     void* getGroupDepPtr(void) const {
       return (void *)((char *)this + totalsize - getGroupDepSize());
     }
-    static envelope *alloc(const UChar type, const UInt size=0, const UShort prio=0, const GroupDepNum groupDepNumRequest=GroupDepNum{}, const bool incEvent=true)
+    static envelope *alloc(const UChar type, const size_t size=0, const UShort prio=0, const GroupDepNum groupDepNumRequest=GroupDepNum{}, const bool incEvent=true)
     {
       CkAssert(type>=NewChareMsg && type<LAST_CK_ENVELOPE_TYPE);
 #if CMK_USE_STL_MSGQ
@@ -298,7 +298,7 @@ public:
       CkAssert(sizeof(CMK_MSG_PRIO_TYPE) >= sizeof(int)*CkPriobitsToInts(prio));
 #endif
 
-      UInt tsize = sizeof(envelope)+ 
+      size_t tsize = sizeof(envelope)+ 
                    CkMsgAlignLength(size)+
                    sizeof(int)*CkPriobitsToInts(prio) +
                    sizeof(CkGroupID)*(int)groupDepNumRequest;
@@ -474,17 +474,17 @@ inline void *EnvToUsr(const envelope *const env) {
   return (void *)((intptr_t)env + sizeof(envelope));
 }
 
-inline envelope *_allocEnv(const int msgtype, const int size=0, const int prio=0, const GroupDepNum groupDepNum=GroupDepNum{}) {
+inline envelope *_allocEnv(const int msgtype, const size_t size=0, const int prio=0, const GroupDepNum groupDepNum=GroupDepNum{}) {
   return envelope::alloc(msgtype,size,prio,groupDepNum);
 }
 
 #if CMK_REPLAYSYSTEM
-inline envelope *_allocEnvNoIncEvent(const int msgtype, const int size=0, const int prio=0, const GroupDepNum groupDepNum=GroupDepNum{}) {
+inline envelope *_allocEnvNoIncEvent(const int msgtype, const size_t size=0, const int prio=0, const GroupDepNum groupDepNum=GroupDepNum{}) {
   return envelope::alloc(msgtype,size,prio,groupDepNum,false);
 }
 #endif
 
-inline void *_allocMsg(const int msgtype, const int size, const int prio=0, const GroupDepNum groupDepNum=GroupDepNum{}) {
+inline void *_allocMsg(const int msgtype, const size_t size, const int prio=0, const GroupDepNum groupDepNum=GroupDepNum{}) {
   return EnvToUsr(envelope::alloc(msgtype,size,prio,groupDepNum));
 }
 
@@ -30,7 +30,7 @@ public:
   LBRealType *comLoads; 	// total comm load
   LBRealType *bgLoads; 	// background load
   int    numPes;
-  int    msgCount;	// total non-local communication
+  CmiUInt8 msgCount;	// total non-local communication
   CmiUInt8  msgBytes;	// total non-local communication
   LBRealType minObjLoad, maxObjLoad;
   LBInfo(): peLoads(NULL), objLoads(NULL), comLoads(NULL), 
@@ -256,6 +256,7 @@ private:
   int lbdone;
   double start_lb_time;
   double strat_start_time;
+  double strat_work_time;  // time spent in work(), part of the strategy time
   LBMigrateMsg   *storedMigrateMsg;
   LBScatterMsg   *storedScatterMsg;
   bool  reduction_started;
@@ -36,6 +36,7 @@ class CkLBArgs
   bool _lb_statson;         // stats collection
   bool _lb_traceComm;       // stats collection for comm
   int _lb_central_pe;      // processor number for centralized strategy
+  int _lb_threads;         // ranks a centralized strategy may use, 0 for all of its node
   int _lb_maxDistPhases;   // Specifies the max number of LB phases in DistributedLB
   double _lb_targetRatio;  // Specifies the target load ratio for LBs that aim for a
                            // particular load ratio
@@ -53,6 +54,7 @@ class CkLBArgs
     _lb_statson = _lb_traceComm = true;
     _lb_loop = false;
     _lb_central_pe = 0;
+    _lb_threads = 0;
     _lb_maxDistPhases = 10;
     _lb_targetRatio = 1.05;
     _lb_metaLbOn = false;
@@ -73,6 +75,7 @@ class CkLBArgs
   inline bool& statsOn() { return _lb_statson; }
   inline bool& traceComm() { return _lb_traceComm; }
   inline int& central_pe() { return _lb_central_pe; }
+  inline int& threads() { return _lb_threads; }
   inline double& alpha() { return _lb_alpha; }
   inline double& beta() { return _lb_beta; }
   inline int& maxDistPhases() { return _lb_maxDistPhases; }
@@ -122,6 +125,9 @@ typedef BaseLB* (*LBAllocFn)();
 void LBDefaultCreate(LBCreateFn f);
 
 void LBRegisterBalancer(std::string, LBCreateFn, LBAllocFn, std::string, bool shown = true);
+/// Allocate a local, unregistered instance of a balancer for running its
+/// strategy directly, e.g. on stats read from an LB dump file
+LBAllocFn getLBAllocFn(const char* lbname);
 
 template <typename T>
 void LBRegisterBalancer(std::string name, std::string description, bool shown = true)
@@ -0,0 +1,84 @@
+/**
+ * \addtogroup CkLdb
+*/
+/*@{*/
+
+/*
+  Node-level parallelism for load balancing strategies. A centralized
+  strategy runs on one PE while the other PEs wait for its decisions; in SMP
+  mode, LBParallelFor hands chunks of a loop to the other ranks of that PE's
+  node, which pick them up from their scheduler queues while they wait.
+
+  Bodies run concurrently on different ranks, so they may only write to
+  disjoint data, and must not depend on which rank runs which chunk. Used
+  that way, a parallel strategy decides exactly as the sequential one does.
+*/
+
+#ifndef LBPARALLEL_H
+#define LBPARALLEL_H
+
+#include "converse.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+/// Number of ranks LBParallelFor spreads loops over, the calling one
+/// included; set with +LBThreads, 1 without SMP
+int LBParallelRanks();
+
+/// Run body(begin, end) on chunks of at most grain indices covering [0, n),
+/// and return when all of them are done
+void LBParallelFor(size_t n, size_t grain,
+                   const std::function<void(size_t, size_t)>& body);
+
+/// Registers the handler of LBParallelFor, called on every PE
+void _LBParallelInit();
+
+/// Sorts below this size are not worth splitting
+#define LB_PARALLEL_SORT_MIN 65536
+
+/// Sort v like std::sort, in runs sorted in parallel and then merged in
+/// parallel. cmp must be a strict total order on the elements (no two
+/// different elements compare equivalent) for the result to be the same as
+/// that of std::sort.
+template <typename T, typename Cmp>
+void LBParallelSort(std::vector<T>& v, Cmp cmp)
+{
+  const size_t n = v.size();
+  const size_t parts = LBParallelRanks();
+  if (parts <= 1 || n < LB_PARALLEL_SORT_MIN)
+  {
+    std::sort(v.begin(), v.end(), cmp);
+    return;
+  }
+
+  size_t run = (n + parts - 1) / parts;
+  LBParallelFor(parts, 1, [&](size_t first, size_t last) {
+    for (size_t p = first; p < last; p++)
+      std::sort(v.begin() + std::min(n, p * run), v.begin() + std::min(n, (p + 1) * run),
+                cmp);
+  });
+
+  std::vector<T> buf(n);
+  std::vector<T>*from = &v, *to = &buf;
+  for (; run < n; run *= 2)
+  {
+    const size_t pairs = (n + 2 * run - 1) / (2 * run);
+    LBParallelFor(pairs, 1, [&](size_t first, size_t last) {
+      for (size_t p = first; p < last; p++)
+      {
+        const size_t lo = p * 2 * run;
+        const size_t mid = std::min(n, lo + run), hi = std::min(n, lo + 2 * run);
+        std::merge(from->begin() + lo, from->begin() + mid, from->begin() + mid,
+                   from->begin() + hi, to->begin() + lo, cmp);
+      }
+    });
+    std::swap(from, to);
+  }
+  if (from != &v) v.swap(buf);
+}
+
+#endif /* LBPARALLEL_H */
+
+/*@}*/
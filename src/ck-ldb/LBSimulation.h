@@ -33,4 +33,12 @@ private:
   friend class CentralLB;   // so that we don't have to provide little get/put functions
 };
 
+/// Read an LB dump file written by +LBDump into stats and set count to the
+/// number of PEs it was written on. With simulate, the PE count of +LBSim is
+/// applied as well. Returns false if the file cannot be opened.
+bool LBReadStatsFile(const char* filename, BaseLB::LDStats* stats, int& count,
+                     bool simulate);
+/// Write stats, collected from count PEs, as an LB dump file
+bool LBWriteStatsFile(const char* filename, BaseLB::LDStats* stats, int count);
+
 #endif /* SIMRESULTS_H */
@@ -423,10 +423,10 @@ class StrategyWrapper : public IStrategyWrapper
 #endif
       {
         CkPrintf(
-            "[%d] strategy %s time=%f secs, maxLoad after strategy=%f, num_migrations=%d "
-            "migrations_sum_hops=%u\n",
-            CkMyPe(), strategy_name.c_str(), strategy_time, maxLoad, migMsg->n_moves,
-            migrations_sum_hops);
+            "[%d] strategy %s time=%f secs (%d threads), maxLoad after strategy=%f, "
+            "num_migrations=%d migrations_sum_hops=%u\n",
+            CkMyPe(), strategy_name.c_str(), strategy_time, LBParallelRanks(), maxLoad,
+            migMsg->n_moves, migrations_sum_hops);
       }
     }
 
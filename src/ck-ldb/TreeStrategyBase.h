@@ -1,6 +1,8 @@
 #ifndef TREESTRATEGYBASE_H
 #define TREESTRATEGYBASE_H
 
+#include "LBParallel.h"
+
 #include <algorithm>
 #include <random>
 
@@ -81,6 +83,18 @@ T* ptr(T* obj)
   return obj;
 }  // obj is already pointer, return it
 
+// Heaviest first, with ties broken by id so that the order is fully determined,
+// as LBParallelSort requires
+template <typename T>
+struct CmpLoadGreaterId
+{
+  inline bool operator()(const T& a, const T& b) const
+  {
+    const auto la = ptr(a)->getLoad(), lb = ptr(b)->getLoad();
+    return la > lb || (la == lb && ptr(a)->id < ptr(b)->id);
+  }
+};
+
 // ---------------- Obj --------------------
 
 struct obj_1_data
@@ -201,23 +215,23 @@ class Proc<N, false, multi>
 };
 
 template <>
-void Proc<1, false>::populate(int _id, float* _bgload, float* _speed)
+inline void Proc<1, false>::populate(int _id, float* _bgload, float* _speed)
 {
   id = _id;
   this->bgload = *_bgload;
 }
 template <>
-float Proc<1, false>::getLoad() const
+inline float Proc<1, false>::getLoad() const
 {
   return this->load;
 }
 template <>
-void Proc<1, false>::assign(const Obj<1>* o)
+inline void Proc<1, false>::assign(const Obj<1>* o)
 {
   this->load += o->load;
 }
 template <>
-void Proc<1, false>::resetLoad()
+inline void Proc<1, false>::resetLoad()
 {
   this->load = this->bgload;
 }
@@ -265,30 +279,42 @@ class Proc<N, true, multi>
 };
 
 template <>
-void Proc<1, true>::populate(int _id, float* _bgload, float* _speed)
+inline void Proc<1, true>::populate(int _id, float* _bgload, float* _speed)
 {
   id = _id;
   this->bgload = *_bgload;
   speed[0] = _speed[0];
 }
 template <>
-float Proc<1, true>::getLoad() const
+inline float Proc<1, true>::getLoad() const
 {
   return this->load;
 }
 template <>
-void Proc<1, true>::assign(const Obj<1>* o)
+inline void Proc<1, true>::assign(const Obj<1>* o)
 {
   this->load += (o->load / speed[0]);
 }
 template <>
-void Proc<1, true>::resetLoad()
+inline void Proc<1, true>::resetLoad()
 {
   this->load = this->bgload;
 }
 
 // ---------------- Strategy --------------------
 
+// Size of a vector that maps real PEs to indices in procs. Strategies normally
+// run on the PEs they balance, but offline tools like lbreplay run them on
+// dumps taken from other numbers of PEs.
+template <typename O, typename P>
+size_t procMapSize(const std::vector<O>& objs, const std::vector<P>& procs)
+{
+  int maxPe = CkNumPes() - 1;
+  for (const auto& p : procs) maxPe = std::max(maxPe, p.id);
+  for (const auto& o : objs) maxPe = std::max(maxPe, o.oldPe);
+  return maxPe + 1;
+}
+
 template <typename O, typename P, typename S>
 class Strategy
 {
@@ -334,7 +360,7 @@ class Rotate : public Strategy<O, P, S>
     std::sort(procs.begin(), procs.end(), CmpId<P>());
     // could use unordered_map but vector is faster and doesn't require much memory, even
     // for a few million PEs
-    std::vector<int> procMap(CkNumPes(), -1);  // real pe -> idx in procs
+    std::vector<int> procMap(procMapSize(objs, procs), -1);  // real pe -> idx in procs
     for (int i = 0; i < procs.size(); i++) procMap[procs[i].id] = i;
     for (const auto& o : objs)
     {
@@ -16,7 +16,7 @@ class Greedy : public Strategy<O, P, S>
  public:
   void solve(std::vector<O>& objs, std::vector<P>& procs, S& solution, bool objsSorted)
   {
-    if (!objsSorted) std::sort(objs.begin(), objs.end(), CmpLoadGreater<O>());
+    if (!objsSorted) LBParallelSort(objs, CmpLoadGreaterId<O>());
     std::priority_queue<P, std::vector<P>, CmpLoadGreater<P>> procHeap(
         CmpLoadGreater<P>(), procs);
     for (const auto& o : objs)
@@ -1,6 +1,7 @@
 #ifndef PROC_HEAP_H
 #define PROC_HEAP_H
 
+#include <algorithm>
 #include <vector>
 
 // custom heap to allow removal of processors from any position
@@ -12,7 +13,9 @@ class ProcHeap
   {
     int index = 1;
     Q.resize(procs.size() + 1);
-    elem_pos.resize(CkNumPes(), 0);
+    int maxPe = CkNumPes() - 1;  // more PEs than that when replaying LB dumps
+    for (auto& p : procs) maxPe = std::max(maxPe, ptr(p)->id);
+    elem_pos.resize(maxPe + 1, 0);
     for (auto& p : procs)
     {
       Q[index] = p;
@@ -24,7 +27,10 @@ class ProcHeap
 
   // IMPORTANT: right now, if procId refers to a processor that is *not* in the heap,
   // elem_pos[procId] refers to position 0, which should contain an invalid processor
-  inline P& getProc(int procId) { return Q[elem_pos[procId]]; }
+  inline P& getProc(int procId)
+  {
+    return Q[procId < elem_pos.size() ? elem_pos[procId] : 0];
+  }
 
   inline P& top()
   {
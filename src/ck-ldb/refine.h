@@ -44,7 +44,7 @@ class RefineA : public Strategy<O, P, S>
 
     std::uniform_int_distribution<int> uni(0, procs.size() - 1);
 
-    std::vector<int> procMap(CkNumPes(), -1);  // real pe -> idx in procs
+    std::vector<int> procMap(procMapSize(objs, procs), -1);  // real pe -> idx in procs
     for (int i = 0; i < procs.size(); i++) procMap[procs[i].id] = i;
     std::unordered_map<int, std::vector<O>> proc_objs0;  // real pe -> list of its objects
     RefineSolution<O, P> initialAssignment(objs.size());
@@ -62,8 +62,13 @@ class RefineA : public Strategy<O, P, S>
         proc_objs0[o.oldPe].push_back(o);
       }
     }
-    for (const auto& p : procs)
-      std::sort(proc_objs0[p.id].begin(), proc_objs0[p.id].end(), CmpLoadGreater<O>());
+    // the lists are created first, operator[] on the map is not thread-safe
+    std::vector<std::vector<O>*> proc_lists;
+    for (const auto& p : procs) proc_lists.push_back(&proc_objs0[p.id]);
+    LBParallelFor(proc_lists.size(), 64, [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; i++)
+        std::sort(proc_lists[i]->begin(), proc_lists[i]->end(), CmpLoadGreaterId<O>());
+    });
 
     std::vector<RefineSolution<O, P>> solutions;
     float lower = M;
@@ -184,7 +189,7 @@ class RefineB : public Strategy<O, P, S>
 
     std::uniform_int_distribution<int> uni(0, procs.size() - 1);
 
-    std::vector<int> procMap(CkNumPes(), -1);  // real pe -> idx in procs
+    std::vector<int> procMap(procMapSize(objs, procs), -1);  // real pe -> idx in procs
     for (int i = 0; i < procs.size(); i++) procMap[procs[i].id] = i;
     std::unordered_map<int, std::vector<O>> proc_objs0;  // real pe -> list of its objects
     RefineSolution<O, P> initialAssignment(objs.size());
@@ -202,8 +207,13 @@ class RefineB : public Strategy<O, P, S>
         proc_objs0[o.oldPe].push_back(o);
       }
     }
-    for (const auto& p : procs)
-      std::sort(proc_objs0[p.id].begin(), proc_objs0[p.id].end(), CmpLoadGreater<O>());
+    // the lists are created first, operator[] on the map is not thread-safe
+    std::vector<std::vector<O>*> proc_lists;
+    for (const auto& p : procs) proc_lists.push_back(&proc_objs0[p.id]);
+    LBParallelFor(proc_lists.size(), 64, [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; i++)
+        std::sort(proc_lists[i]->begin(), proc_lists[i]->end(), CmpLoadGreaterId<O>());
+    });
 
     std::vector<RefineSolution<O, P>> solutions;
     float lower = M;
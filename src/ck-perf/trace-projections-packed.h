@@ -0,0 +1,146 @@
+/**
+ * \addtogroup CkPerf
+*/
+/*@{*/
+
+/*
+  The packed Projections log format, written with +packed-trace and turned
+  back into the text format by projections-unpack.
+
+  A packed log starts with a PackedLogHeader, followed by blocks that are each
+  a PackedLogBlockHeader and the block's bytes, LZ4-compressed if that made
+  them smaller.  A block holds one token for each value the text log would
+  contain, so that the converter needs no knowledge of the record layouts: a
+  tag byte with the kind of value (ORed with PACKED_SINGLE if there is just
+  one value, otherwise a varint count follows) and then the values.  Integers
+  are stored as zigzag-encoded varints of the difference to the same field of
+  the previous record of the same type, which turns constant fields into zeros
+  and counters into ones.  64-bit unsigned fields are timestamps, and the
+  first one of a record is taken relative to that of the previous record of
+  any type instead.  Each block starts from a fresh PackedLogContext, so
+  blocks can be decoded independently.
+
+  This header is used outside of Charm++ programs, so it must not depend on
+  anything but the standard library.
+*/
+
+#ifndef _TRACE_PROJECTIONS_PACKED_H
+#define _TRACE_PROJECTIONS_PACKED_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PACKED_LOG_MAGIC   "PROJPACK"
+#define PACKED_LOG_VERSION 1
+
+/// Raw size at which the writer starts a new block
+#define PACKED_LOG_BLOCK_SIZE (256*1024)
+
+struct PackedLogHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t blockSize;
+};
+
+struct PackedLogBlockHeader {
+  uint32_t rawSize;
+  uint32_t storedSize; // equal to rawSize if the block is not compressed
+};
+
+/// Kinds of tokens, each printed the way toProjectionsFile prints them
+enum PackedLogToken {
+  PACKED_CHARS,    // raw bytes, "%c"
+  PACKED_UBYTES,   // raw bytes, "%d"
+  PACKED_SIGNED,   // varint differences, " %lld"
+  PACKED_UNSIGNED, // varint differences, " %llu"
+  PACKED_TIME,     // varint differences, " %llu"
+  PACKED_FLOAT,    // raw 4-byte floats, " %.7g"
+  PACKED_DOUBLE,   // raw 8-byte doubles, " %.15g"
+  PACKED_SINGLE = 0x80
+};
+
+/// Integer fields of a record that are stored as differences
+#define PACKED_LOG_FIELDS 16
+
+/// What the differences refer to, kept identically by writer and reader
+class PackedLogContext {
+  uint64_t lastTime;
+  uint64_t last[256][PACKED_LOG_FIELDS];
+  uint64_t unrelated;
+  int type, field;
+  bool recordStart, timeSeen;
+
+public:
+  PackedLogContext() { reset(); }
+
+  void reset() {
+    lastTime = 0;
+    memset(last, 0, sizeof(last));
+    type = 0;
+    field = 0;
+    recordStart = true;
+    timeSeen = false;
+  }
+
+  bool atRecordStart() const { return recordStart; }
+
+  /// Every text record ends in a newline, and the next one starts with its type
+  void sawChars(const char *p, size_t n) {
+    recordStart = (n > 0 && p[n-1] == '\n');
+  }
+  void sawUBytes(const unsigned char *p, size_t n) {
+    if (recordStart) {
+      type = p[0];
+      field = 0;
+      timeSeen = false;
+    }
+    recordStart = false;
+  }
+  void sawOther() { recordStart = false; }
+
+  /// The value the next integer is stored relative to; the caller updates it
+  uint64_t &nextBase(bool isTime) {
+    int f = field++;
+    if (isTime && !timeSeen) {
+      timeSeen = true;
+      return lastTime;
+    }
+    if (f < PACKED_LOG_FIELDS) return last[type][f];
+    unrelated = 0;
+    return unrelated;
+  }
+};
+
+static inline void packedPutVarint(char *&out, uint64_t v) {
+  while (v >= 0x80) {
+    *out++ = (char)(v | 0x80);
+    v >>= 7;
+  }
+  *out++ = (char)v;
+}
+
+/// Returns false if the varint runs past end
+static inline bool packedGetVarint(const char *&in, const char *end, uint64_t &v) {
+  v = 0;
+  for (int shift = 0; in < end && shift < 64; shift += 7) {
+    unsigned char c = *in++;
+    v |= (uint64_t)(c & 0x7f) << shift;
+    if (!(c & 0x80)) return true;
+  }
+  return false;
+}
+
+static inline uint64_t packedZigzag(int64_t v) {
+  return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static inline int64_t packedUnzigzag(uint64_t v) {
+  return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+/// Longest encoding of one value
+#define PACKED_MAX_VALUE_BYTES 10
+
+#endif
+
+/*@}*/
@@ -25,6 +25,7 @@
 #endif
 
 #include "pup.h"
+#include "trace-projections-packed.h"
 
 #define PROJECTION_VERSION  "11.0"
 
@@ -277,6 +278,7 @@ class LogEntry {
 };
 
 class TraceProjections;
+class toProjectionsPacked;
 
 /// log pool in trace projection
 class LogPool {
@@ -292,6 +294,7 @@ class LogPool {
     bool writeData;
     bool writeSummaryFiles;
     bool binary;
+    bool packed;
     bool hasFlushed;
     bool headerWritten;
     bool fileCreated;
@@ -314,6 +317,8 @@ class LogPool {
     gzFile deltazfp;
     gzFile zfp;
 #endif
+    // encoder for the packed format, which streams to fp through PackedLogStream
+    toProjectionsPacked *packer;
     // **CW** prevTime stores the timestamp of the last event
     // written out to log. This allows the implementation of
     // simple delta encoding and should only be used when
@@ -355,6 +360,7 @@ class LogPool {
     LogPool(char *pgm);
     ~LogPool();
     void setBinary(int b) { binary = (b!=0); }
+    void setPacked(int p) { packed = (p!=0); }
     void setNumSubdirs(int n) { nSubdirs = n; }
     void setWriteSummaryFiles(int n) { writeSummaryFiles = (n!=0)? true : false;}
 #if CMK_USE_ZLIB
@@ -623,6 +629,30 @@ class fromProjectionsFile : public fromTextFile {
   fromProjectionsFile(FILE *f_) :fromTextFile(f_) {}
 };
 
+class PackedLogStream;
+
+/// Encodes records in the packed format (see trace-projections-packed.h) and
+/// hands each full block to the comm thread of SMP builds, so that the PE
+/// rarely waits for compression or the file system.
+class toProjectionsPacked : public PUP::er {
+  PackedLogStream *stream;
+  std::vector<char> *block;
+  PackedLogContext context;
+
+  void newBlock();
+  void pushBlock();
+ protected:
+  virtual void bytes(void *p,size_t n,size_t itemSize,dataType t);
+  virtual void pup_buffer(void *&p,size_t n,size_t itemSize,dataType t);
+  virtual void pup_buffer(void *&p,size_t n, size_t itemSize, dataType t, std::function<void *(size_t)> allocate, std::function<void (void *)> deallocate);
+ public:
+  //Begin writing to this file, which should be opened for binary write.
+  toProjectionsPacked(FILE *f);
+  //Write out everything encoded so far and wait until it is on disk
+  void finish();
+  ~toProjectionsPacked();
+};
+
 #if CMK_USE_ZLIB
 class toProjectionsGZFile : public PUP::er {
   gzFile f;
@@ -8,6 +8,7 @@
 
 #include <stdio.h>
 #include <errno.h>
+#include <vector>
 
 #include "trace.h"
 #include "envelope.h"
@@ -132,6 +133,71 @@ class PhaseTable {
 double epThreshold;
 double epInterval;
 
+/**
+   Log-linear (HDR-style) histogram buckets for the execution times of entry
+   methods in +sumStream mode, in nanoseconds: times below
+   2^SUM_HIST_SUB_BITS get a bucket each, and every power of two above that
+   is split into 2^SUM_HIST_SUB_BITS buckets, so that each bucket is at most
+   1/16 of its lower bound wide.  Times of 2^SUM_HIST_MAX_BITS ns (about 18
+   minutes) or more go into the last bucket.
+*/
+#define SUM_HIST_SUB_BITS   4
+#define SUM_HIST_MAX_BITS   40
+#define SUM_HIST_BUCKETS    ((SUM_HIST_MAX_BITS - SUM_HIST_SUB_BITS + 1) << SUM_HIST_SUB_BITS)
+
+inline int sumHistBucket(double t)
+{
+  CmiUInt8 ns = t > 0. ? (CmiUInt8)(t * 1.0e9) : 0;
+  if (ns >> SUM_HIST_MAX_BITS) return SUM_HIST_BUCKETS - 1;
+  if (ns < (1 << SUM_HIST_SUB_BITS)) return (int)ns;
+#if defined(__GNUC__) || defined(__clang__)
+  int lg = 63 - __builtin_clzll((unsigned long long)ns);
+#else
+  int lg = 0;
+  for (CmiUInt8 v = ns; v >>= 1; ) lg++;
+#endif
+  int shift = lg - SUM_HIST_SUB_BITS;
+  return ((shift + 1) << SUM_HIST_SUB_BITS) |
+         (int)((ns >> shift) & ((1 << SUM_HIST_SUB_BITS) - 1));
+}
+
+/// Executions of one entry method per bucket since the last collection
+struct SumStreamHist {
+  CmiUInt4 counts[SUM_HIST_BUCKETS];
+  bool touched;
+};
+
+/**
+   Layout of the +sumStream reduction messages and of the replies to the
+   "CkPerfSummaryStream" CCS handler: this header, numBins BinEntry with the
+   busy and idle seconds of consecutive bins summed over all PEs, numPes
+   SumStreamPe and numCounts SumStreamCount sorted by entry and bucket.
+   The reduction carries the counts since the previous collection, the
+   replies the counts since the start of the run.
+*/
+#define SUM_STREAM_VERSION 1
+
+struct SumStreamHeader {
+  int version;
+  int numBins;
+  int numPes;
+  int numCounts;
+  CmiInt8 firstBin;  ///< index of the first bin since the start of the run
+  double binSize;
+};
+
+/// Fractions of the bins of a collection a PE spent in each state
+struct SumStreamPe {
+  int pe;
+  float busy, idle, overhead;
+};
+
+struct SumStreamCount {
+  int ep;
+  int bucket;
+  CmiUInt8 count;
+};
+
 /// info for each entry
 class SumEntryInfo {
 public:
@@ -185,6 +251,11 @@ class SumLogPool {
     double *cpuTime;    //[MAX_INTERVALS * MAX_ENTRIES];
     int *numExecutions; //[MAX_INTERVALS * MAX_ENTRIES];
 
+    /// for +sumStream, where pool is a ring of the last poolSize bins
+    CmiInt8 totalBins;
+    SumStreamHist **epHist;
+    std::vector<int> touchedEps;
+
   public:
     SumLogPool(char *pgm);
     ~SumLogPool();
@@ -237,6 +308,9 @@ class SumLogPool {
 
     void updateSummaryDetail(int epIdx, double startTime, double endTime);
 
+    /// Append the data of bins [firstBin, firstBin+nBins) to a +sumStream
+    /// contribution, and the executions since the previous call
+    void packStream(CmiInt8 firstBin, int nBins, std::vector<char> &out);
 
 };
 
@@ -256,6 +330,7 @@ class TraceSummary : public Trace {
     double binStart; /* time of last filled bin? */
     double start, packstart, unpackstart, idleStart;
     double binTime, binIdle;
+    double binOrigin;
     int inIdle;
     int inExec;
     int depth;
@@ -298,6 +373,9 @@ class TraceSummary : public Trace {
     */
     SumLogPool *pool() { return _logPool; }
 
+    /// index of the bin the given time falls in, counted from the start
+    CmiInt8 binIndex(double t);
+
     /**
      *  Supporting methods for CCS queries
      */
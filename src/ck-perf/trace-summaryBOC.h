@@ -1,9 +1,13 @@
 #include "ckcallback-ccs.h"
 #include "TraceSummary.decl.h"
 #include <deque>
+#include <string>
+#include <vector>
 
 extern CkGroupID traceSummaryGID;
 extern bool summaryCcsStreaming;
+extern int sumStream;
+extern CkReduction::reducerType sumStreamReducer;
 
 class TraceSummaryInit : public Chare {
  public:
@@ -35,9 +39,19 @@ public:
   CkVec<double> *ccsBufferedData;
   int nextBinIndexCcs;
 
+  /* +sumStream data, on PE 0 */
+  bool streamPending;     // a collection is under way
+  CmiInt8 streamNextBin;  // first bin not asked for yet
+  CmiInt8 streamTotalBins; // index after the last bin received
+  std::vector<BinEntry> streamBins; // ring of the last bins, summed over PEs
+  std::vector<SumStreamPe> streamPes; // fractions of the last collection
+  std::vector<std::vector<CmiUInt8> > streamHist; // counts per entry and bucket
+
 public:
   TraceSummaryBOC(void): count(0), bins(NULL), nBins(0), 
-    nTracedPEs(0), firstTime(true), nextBinIndexCcs(0) {}
+    nTracedPEs(0), firstTime(true), nextBinIndexCcs(0) {
+    if (sumStream && CkMyPe() == 0) initStream();
+  }
   TraceSummaryBOC(CkMigrateMessage *m):CBase_TraceSummaryBOC(m) {}
   void startSumOnly();
   void askSummary(int size);
@@ -51,6 +65,14 @@ public:
   void collectSummaryData(double startTime, double binSize, int numBins);
   void summaryDataCollected(double *recvData, int numBins);
 
+  /* +sumStream methods/entry methods */
+  void initStream();
+  void startStreamCollection(double currT);
+  void collectStream(CmiInt8 firstBin, int numBins);
+  void streamCollected(CkReductionMsg *m);
+  void ccsRequestStream(CkCcsRequestMsg *m);
+  void ccsRequestStreamNames(CkCcsRequestMsg *m);
+
   void traceSummaryParallelShutdown(int pe);
   void maxBinSize(double _maxBinSize);
   void shrink(double _maxBinSize);
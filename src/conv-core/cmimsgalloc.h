@@ -0,0 +1,40 @@
+/* Per-PE size-class allocator behind CmiAlloc, see cmimsgalloc.C */
+#ifndef CMIMSGALLOC_H
+#define CMIMSGALLOC_H
+
+#include "converse.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/* Counters kept by each PE (and communication thread), in the spirit of the
+   MEMMONITOR counters of CmiAlloc */
+typedef struct {
+  CmiUInt8 allocs;      /* blocks handed out from the size classes */
+  CmiUInt8 largeAllocs; /* requests too large for a size class, passed to malloc */
+  CmiUInt8 localFrees;  /* blocks freed by the PE that allocated them */
+  CmiUInt8 remoteFrees; /* blocks this PE freed on behalf of another one */
+  CmiUInt8 reclaimed;   /* blocks other PEs handed back to this one */
+  CmiUInt8 bytesInUse;  /* bytes in blocks allocated here and not handed back yet */
+  CmiUInt8 hiWaterMark; /* largest bytesInUse so far */
+  CmiUInt8 slabBytes;   /* memory obtained from the OS for slabs */
+} CmiMsgAllocStats;
+
+void CmiMsgAllocInit(char **argv);
+
+/* Allocate and free the memory for a message, including its CmiChunkHeader */
+void *CmiMsgAlloc(size_t size);
+void CmiMsgFree(void *ptr);
+
+/* Hand blocks freed for other PEs back to them now instead of in batches */
+void CmiMsgAllocFlush(void);
+
+/* Fill in the calling PE's counters; returns 0 if the allocator is not in use */
+int CmiMsgAllocGetStats(CmiMsgAllocStats *stats);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CMIMSGALLOC_H */
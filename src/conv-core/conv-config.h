@@ -114,6 +114,22 @@
 #define CMK_SMP                   0
 #endif
 
+/* Serve CmiAlloc from per-PE size classes (cmimsgalloc.C) on layers that
+   would otherwise malloc every message, in SMP builds */
+#if !defined(CMK_MSGALLOC_AVAILABLE)
+#define CMK_MSGALLOC_AVAILABLE    0
+#endif
+
+#if !defined(CMK_USE_MSGALLOC)
+#define CMK_USE_MSGALLOC          (CMK_MSGALLOC_AVAILABLE && CMK_SMP)
+#endif
+
+/* Machine layers that can carry a single message of 2 GB or more; on the
+   others, such sends abort instead of being silently truncated */
+#if !defined(CMK_LARGE_MSG_AVAILABLE)
+#define CMK_LARGE_MSG_AVAILABLE   0
+#endif
+
 #if CMK_SMP_TRACE_COMMTHREAD && ! CMK_SMP
 #undef CMK_SMP_TRACE_COMMTHREAD
 #define CMK_SMP_TRACE_COMMTHREAD                               0
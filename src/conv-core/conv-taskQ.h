@@ -9,12 +9,25 @@
 #define TASKQ_WORK_EVENTID 147
 #define TASKQ_STEAL_EVENTID 149
 #define TASKQ_QUEUE_STEAL_EVENTID 151
+#define TASKQ_STEAL_ATTEMPTS_STATID 153
+#define TASKQ_STEAL_SUCCESSES_STATID 155
+#define TASKQ_STEAL_FAILURES_STATID 157
+#define TASKQ_TASKS_STOLEN_STATID 159
 #endif
 #ifdef __cplusplus
 extern "C" {
 #endif
+/* Per-PE counters of StealTask; one attempt is one probe of a victim's queue */
+typedef struct {
+  CmiUInt8 attempts;
+  CmiUInt8 successes; /* Attempts that took at least one task */
+  CmiUInt8 failures; /* Attempts that found the victim's queue empty */
+  CmiUInt8 tasksStolen;
+} CmiTaskQueueStealStats;
+
 void StealTask();
-void CmiTaskQueueInit();
+void CmiTaskQueueInit(char **argv);
+void CmiTaskQueueGetStealStats(CmiTaskQueueStealStats *stats);
 #ifdef __cplusplus
 }
 #endif
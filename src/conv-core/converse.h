@@ -353,6 +353,7 @@ typedef struct {
 } CmiSpanningTreeInfo;
 
 extern CmiSpanningTreeInfo* _topoTree; // this node's parent and children in topo-tree rooted at 0
+extern int _Cmi_bcastBranchFactor; // number of children of each node in broadcast spanning trees
 
 #if CMK_SHARED_VARS_UNAVAILABLE /* Non-SMP version of shared vars. */
 extern int _Cmi_mype;
@@ -421,6 +422,7 @@ extern int _Cmi_mynode;
 extern int _Cmi_numnodes;
 extern int _Cmi_sleepOnIdle;
 extern int _Cmi_forceSpinOnIdle;
+extern int _Cmi_idleSpinUs;
 
 int CmiMyPe(void);
 int CmiMyRank(void);
@@ -688,6 +690,7 @@ extern int CmiSetCPUAffinity(int core);
 extern int CmiSetCPUAffinityLogical(int core);
 extern void CmiInitCPUTopology(char **argv);
 extern int CmiOnCore(void);
+extern void CmiGetMyLocality(int *socket, int *numa);
 
 typedef struct
 {
@@ -796,7 +799,7 @@ CpvExtern(int, _curRestartPhase);      /* number of restarts */
     See the comment in convcore.C for details on the fields.
 */
 struct CmiChunkHeader {
-  int size;
+  size_t size;
 private:
 #if CMK_SMP
   std::atomic<int> ref;
@@ -811,12 +814,12 @@ private:
   #pragma GCC diagnostic ignored "-Wunused-private-field"
   #endif
   #endif
-  char align[ALIGN_BYTES
-             - sizeof(int)*2
+  char align[(ALIGN_BYTES
+              - (sizeof(size_t) + sizeof(int)
 #if (CMK_USE_IBVERBS || CMK_USE_IBUD)
-             - sizeof(void *)
+                 + sizeof(void *)
 #endif
-            ];
+                ) % ALIGN_BYTES) % ALIGN_BYTES];
   #if defined(__GNUC__) || defined(__clang__)
   #pragma GCC diagnostic pop
   #endif
@@ -896,13 +899,13 @@ void free_nomigrate(void* ptr);
    in which to construct messages should prefer the malloc()/free()
    provided by libmemory-*.
 */
-void    *CmiAlloc(int size);
+void    *CmiAlloc(size_t size);
 void     CmiReference(void *blk);
 int      CmiGetReference(void *blk);
-int      CmiSize(void *blk);
+size_t   CmiSize(void *blk);
 void     CmiFree(void *blk);
 void     CmiRdmaFree(void *blk);
-void     CmiInitMsgHeader(void *msg, int size);
+void     CmiInitMsgHeader(void *msg, size_t size);
 
 #ifndef CMI_TMP_SKIP
 void *CmiTmpAlloc(int size);
@@ -1288,32 +1291,32 @@ void CmiPushPE(int, void*);
 void          CmiSuspendedTaskEnqueue(int targetRank, void *msg);
 void      *   CmiSuspendedTaskPop(void);
 #endif
-void          CmiSyncSendFn(int, int, char *);
-CmiCommHandle CmiAsyncSendFn(int, int, char *);
-void          CmiFreeSendFn(int, int, char *);
+void          CmiSyncSendFn(int, size_t, char *);
+CmiCommHandle CmiAsyncSendFn(int, size_t, char *);
+void          CmiFreeSendFn(int, size_t, char *);
 
-void          CmiSyncBroadcastFn(int, char *);
-CmiCommHandle CmiAsyncBroadcastFn(int, char *);
-void          CmiFreeBroadcastFn(int, char *);
+void          CmiSyncBroadcastFn(size_t, char *);
+CmiCommHandle CmiAsyncBroadcastFn(size_t, char *);
+void          CmiFreeBroadcastFn(size_t, char *);
 
-void          CmiSyncBroadcastAllFn(int, char *);
-CmiCommHandle CmiAsyncBroadcastAllFn(int, char *);
-void          CmiFreeBroadcastAllFn(int, char *);
+void          CmiSyncBroadcastAllFn(size_t, char *);
+CmiCommHandle CmiAsyncBroadcastAllFn(size_t, char *);
+void          CmiFreeBroadcastAllFn(size_t, char *);
 
-void          CmiWithinNodeBroadcastFn(int, char*);
+void          CmiWithinNodeBroadcastFn(size_t, char*);
 
-void          CmiSyncListSendFn(int, const int *, int, char*);
-CmiCommHandle CmiAsyncListSendFn(int, const int *, int, char*);
-void          CmiFreeListSendFn(int, const int *, int, char*);
-void          CmiFreeNodeListSendFn(int, const int *, int, char*);
+void          CmiSyncListSendFn(int, const int *, size_t, char*);
+CmiCommHandle CmiAsyncListSendFn(int, const int *, size_t, char*);
+void          CmiFreeListSendFn(int, const int *, size_t, char*);
+void          CmiFreeNodeListSendFn(int, const int *, size_t, char*);
 
-void          CmiSyncMulticastFn(CmiGroup, int, char*);
-CmiCommHandle CmiAsyncMulticastFn(CmiGroup, int, char*);
-void          CmiFreeMulticastFn(CmiGroup, int, char*);
+void          CmiSyncMulticastFn(CmiGroup, size_t, char*);
+CmiCommHandle CmiAsyncMulticastFn(CmiGroup, size_t, char*);
+void          CmiFreeMulticastFn(CmiGroup, size_t, char*);
 
 /* inter partition send counterparts */
-void          CmiInterSyncSendFn(int, int, int, char *);
-void          CmiInterFreeSendFn(int, int, int, char *);
+void          CmiInterSyncSendFn(int, int, size_t, char *);
+void          CmiInterFreeSendFn(int, int, size_t, char *);
 
 typedef void * (*CmiReduceMergeFn)(int*,void*,void**,int);
 typedef void (*CmiReducePupFn)(void*,void*);
@@ -1409,21 +1412,21 @@ void          CmiReleaseCommHandle(CmiCommHandle);
 /* support for rest may come later if required */
 
 #if CMK_NODE_QUEUE_AVAILABLE
-void          CmiSyncNodeSendFn(int, int, char *);
-CmiCommHandle CmiAsyncNodeSendFn(int, int, char *);
-void          CmiFreeNodeSendFn(int, int, char *);
+void          CmiSyncNodeSendFn(int, size_t, char *);
+CmiCommHandle CmiAsyncNodeSendFn(int, size_t, char *);
+void          CmiFreeNodeSendFn(int, size_t, char *);
 
-void          CmiSyncNodeBroadcastFn(int, char *);
-CmiCommHandle CmiAsyncNodeBroadcastFn(int, char *);
-void          CmiFreeNodeBroadcastFn(int, char *);
+void          CmiSyncNodeBroadcastFn(size_t, char *);
+CmiCommHandle CmiAsyncNodeBroadcastFn(size_t, char *);
+void          CmiFreeNodeBroadcastFn(size_t, char *);
 
-void          CmiSyncNodeBroadcastAllFn(int, char *);
-CmiCommHandle CmiAsyncNodeBroadcastAllFn(int, char *);
-void          CmiFreeNodeBroadcastAllFn(int, char *);
+void          CmiSyncNodeBroadcastAllFn(size_t, char *);
+CmiCommHandle CmiAsyncNodeBroadcastAllFn(size_t, char *);
+void          CmiFreeNodeBroadcastAllFn(size_t, char *);
 
 /* if node queue is available, adding inter partition counterparts */
-void          CmiInterSyncNodeSendFn(int, int, int, char *);
-void          CmiInterFreeNodeSendFn(int, int, int, char *);
+void          CmiInterSyncNodeSendFn(int, int, size_t, char *);
+void          CmiInterFreeNodeSendFn(int, int, size_t, char *);
 #endif
 
 #if CMK_NODE_QUEUE_AVAILABLE
@@ -1931,7 +1934,7 @@ int CmiIsFortranLibraryCall(void);
 CpvExtern(void*, CmiLocalQueue);
 #endif
 
-char *CmiCopyMsg(char *msg, int len);
+char *CmiCopyMsg(char *msg, size_t len);
 
 /******** Hypercube broadcast propagation (Binomial tree) ********/
 
@@ -2270,6 +2273,7 @@ CpvExtern(int,charmLibExitFlag);
 
 size_t CmiFwrite(const void *ptr, size_t size, size_t nmemb, FILE *f);
 CmiInt8 CmiPwrite(int fd, const char *buf, size_t bytes, size_t offset);
+CmiInt8 CmiPread(int fd, char *buf, size_t bytes, size_t offset);
 int CmiOpen(const char *pathname, int flags, int mode);
 FILE *CmiFopen(const char *path, const char *mode);
 int CmiFclose(FILE *fp);
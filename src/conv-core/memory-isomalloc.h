@@ -37,6 +37,9 @@ void CmiIsomallocContextEnableRandomAccess(CmiIsomallocContext ctx);
 void CmiIsomallocContextJustMigrated(CmiIsomallocContext ctx);
 void CmiIsomallocEnableRDMA(CmiIsomallocContext ctx, int enable); /* on by default */
 CmiIsomallocRegion CmiIsomallocContextGetUsedExtent(CmiIsomallocContext ctx);
+/* PE that the contexts being packed emigrate to, -1 (the default) when not
+ * packing a migration; lets +isomalloc_incremental send only what changed */
+void CmiIsomallocSetMigrationTarget(int pe);
 
 /*Allocate/free from this context*/
 void * CmiIsomallocContextMalloc(CmiIsomallocContext ctx, size_t size);
@@ -79,6 +79,36 @@ typedef struct prioqelt_struct
 }
 *_prioqelt;
 #endif
+/**
+   Number of buckets in the radix front of a priority queue. Must be a
+   multiple of 64, and at most 64*64 so that one summary word covers
+   the bitmap.
+*/
+#define CQS_RADIX_BUCKETS 1024
+
+/**
+   A bucket array indexed directly by priority, covering the window of
+   single-word priorities [base, base+CQS_RADIX_BUCKETS). Non-empty
+   buckets are tracked by a two-level bitmap, so finding the highest
+   priority bucket is a pair of bit scans.
+*/
+typedef struct radixq_struct
+{
+  unsigned int base; /**< Priority word mapped to bucket 0 */
+  CMK_TYPEDEF_UINT8 summary; /**< Bit i is set iff bitmap[i] is non-zero */
+  CMK_TYPEDEF_UINT8 bitmap[CQS_RADIX_BUCKETS/64]; /**< Bit i is set iff bucket i is in use */
+  struct prio_struct top; /**< Priority of the first bucket in use, see CqsGetPriority */
+  struct deq_struct bucket[CQS_RADIX_BUCKETS];
+}
+*_radixq;
+
+/**
+   When set before CqsCreate, the new Queue routes short priorities
+   through a radix front (see radixq_struct) and only uses the heap
+   for priorities outside of its window. Set by +radixMsgQ.
+*/
+extern int CqsRadixQueueEnabled;
+
 /*
 #ifndef FASTQ
 #define PRIOQ_TABSIZE 1017
@@ -100,6 +130,7 @@ typedef struct prioq_struct
   _prioqelt *hashtab;
   int hash_key_size;
   int hash_entry_size;
+  _radixq radix; /**< Optional bucket array for short priorities, or NULL */
 }
 *_prioq;
 /*#else
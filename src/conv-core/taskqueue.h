@@ -1,80 +1,197 @@
 #ifndef _CKTASKQUEUE_H
 #define _CKTASKQUEUE_H
+/* The task queue is built on C++11 atomics, so it is only available to C++ code. */
+#if defined(__cplusplus)
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+/* Initial number of slots in a task queue; the queue doubles whenever it fills up. */
 #define TaskQueueSize 1024
 //Uncomment for debug print statements
 #define TaskQueueDebug(...) //CmiPrintf(__VA_ARGS__)
-// This taskqueue implementation refers to the work-stealing queue of Cilk (THE protocol).
-// New tasks are pushed into the tail of this queue and the tasks are popped at the tail of this queue by the same thread. Thieves(other threads trying to steal) steal a task at the head of this queue.
+// This taskqueue implementation is the Chase-Lev work-stealing deque, with the memory
+// orderings of Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models" (PPoPP'13).
+// New tasks are pushed into the bottom of this queue and the tasks are popped at the bottom of this queue by the same thread.
+// Thieves (other threads trying to steal) steal a task at the top of this queue.
 // So, synchronization is needed only when there is only one task in the queue because thieves and victim can try to obtain the same task.
-#ifdef _WIN32
-#define WIN32_LEAN_AND_MEAN
-#include <windows.h>
-typedef LONG taskq_idx;
-#else
-typedef int taskq_idx;
-#endif
+//
+// The owner grows the circular buffer when it is full. A thief may still be reading the
+// old buffer at that point, so old buffers are retired with the current epoch and only
+// freed once every thief has left that epoch (see TaskQueueReclaim).
+typedef CmiInt8 taskq_idx;
+
+typedef struct TaskQueueArrayStruct {
+  taskq_idx size; // Always a power of two
+  struct TaskQueueArrayStruct *retiredNext; // Next buffer on the retired list
+  taskq_idx retiredEpoch; // Epoch at which this buffer was replaced
+  std::atomic<void *> data[1];
+} *TaskQueueArray;
+
 typedef struct TaskQueueStruct {
-  taskq_idx head; // This pointer indicates the first task in the queue
-  taskq_idx tail; // The tail indicates the array element next to the last available task in the queue. So, if head == tail, the queue is empty
-  void *data[TaskQueueSize];
+  alignas(CMI_CACHE_LINE_SIZE) std::atomic<taskq_idx> top; // Index of the first task in the queue, advanced by thieves
+  alignas(CMI_CACHE_LINE_SIZE) std::atomic<taskq_idx> bottom; // Index past the last task in the queue. So, if top >= bottom, the queue is empty
+  std::atomic<TaskQueueArray> array;
+  // Owner-only state for reclaiming buffers replaced by TaskQueueGrow
+  TaskQueueArray retired;
+  alignas(CMI_CACHE_LINE_SIZE) std::atomic<taskq_idx> epoch;
+  int numThieves;
+  std::atomic<taskq_idx> *thiefEpoch; // Epoch each thief entered with, or 0 when not stealing
 } *TaskQueue;
 
+inline static TaskQueueArray TaskQueueArrayCreate(taskq_idx size) {
+  TaskQueueArray a = (TaskQueueArray)malloc(sizeof(struct TaskQueueArrayStruct) + (size-1)*sizeof(std::atomic<void *>));
+  a->size = size;
+  a->retiredNext = NULL;
+  a->retiredEpoch = 0;
+  for (taskq_idx i = 0; i < size; i++) new (&a->data[i]) std::atomic<void *>(NULL);
+  return a;
+}
+
 inline static TaskQueue TaskQueueCreate() {
   TaskQueue t = (TaskQueue)malloc(sizeof(struct TaskQueueStruct));
-  t->head = 0;
-  t->tail = 0;
+  new (&t->top) std::atomic<taskq_idx>(0);
+  new (&t->bottom) std::atomic<taskq_idx>(0);
+  new (&t->array) std::atomic<TaskQueueArray>(TaskQueueArrayCreate(TaskQueueSize));
+  t->retired = NULL;
+  new (&t->epoch) std::atomic<taskq_idx>(1);
+  // Any rank on the node, including the comm thread, may steal from this queue
+  t->numThieves = CmiMyNodeSize() + 1;
+  t->thiefEpoch = (std::atomic<taskq_idx> *)malloc(t->numThieves * sizeof(std::atomic<taskq_idx>));
+  for (int i = 0; i < t->numThieves; i++) new (&t->thiefEpoch[i]) std::atomic<taskq_idx>(0);
   return t;
 }
 
+// Free the retired buffers that no thief can still be reading. Called by the owner only.
+inline static void TaskQueueReclaim(TaskQueue Q) {
+  taskq_idx oldest = Q->epoch.load(std::memory_order_relaxed);
+  for (int i = 0; i < Q->numThieves; i++) {
+    taskq_idx e = Q->thiefEpoch[i].load(std::memory_order_seq_cst);
+    if (e != 0 && e < oldest) oldest = e;
+  }
+  TaskQueueArray *prev = &Q->retired;
+  while (*prev != NULL) {
+    TaskQueueArray a = *prev;
+    if (a->retiredEpoch < oldest) {
+      *prev = a->retiredNext;
+      free(a);
+    } else {
+      prev = &a->retiredNext;
+    }
+  }
+}
+
+// Double the buffer of a full queue, copying the live tasks [t, b). Called by the owner only.
+inline static TaskQueueArray TaskQueueGrow(TaskQueue Q, TaskQueueArray a, taskq_idx b, taskq_idx t) {
+  TaskQueueArray n = TaskQueueArrayCreate(a->size << 1);
+  TaskQueueDebug("[%d] TaskQueueGrow to %lld slots\n", CmiMyPe(), (long long)n->size);
+  for (taskq_idx i = t; i < b; i++)
+    n->data[i & (n->size-1)].store(a->data[i & (a->size-1)].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  Q->array.store(n, std::memory_order_seq_cst);
+  // Thieves that enter after the epoch bump are guaranteed to see the new buffer
+  a->retiredEpoch = Q->epoch.fetch_add(1, std::memory_order_seq_cst);
+  a->retiredNext = Q->retired;
+  Q->retired = a;
+  TaskQueueReclaim(Q);
+  return n;
+}
+
+inline static void TaskQueueDestroy(TaskQueue Q) {
+  while (Q->retired != NULL) {
+    TaskQueueArray a = Q->retired;
+    Q->retired = a->retiredNext;
+    free(a);
+  }
+  free(Q->array.load(std::memory_order_relaxed));
+  free(Q->thiefEpoch);
+  free(Q);
+}
+
 inline static void TaskQueuePush(TaskQueue Q, void *data) {
-  Q->data[ Q->tail % TaskQueueSize] = data;
-  CmiMemoryWriteFence();
-  Q->tail +=1;
+  taskq_idx b = Q->bottom.load(std::memory_order_relaxed);
+  taskq_idx t = Q->top.load(std::memory_order_acquire);
+  TaskQueueArray a = Q->array.load(std::memory_order_relaxed);
+  if (b - t > a->size - 1)
+    a = TaskQueueGrow(Q, a, b, t);
+  a->data[b & (a->size-1)].store(data, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  Q->bottom.store(b+1, std::memory_order_relaxed);
 }
 
 inline static void* TaskQueuePop(TaskQueue Q) { // Pop happens in the same worker thread which pushed the task before.
-  TaskQueueDebug("[%d] TaskQueuePop head %d tail %d\n", CmiMyPe(), Q->head, Q->tail);
-  taskq_idx h, t;
-  t = Q->tail -1;
-  Q->tail = t;
-  CmiMemoryWriteFence();
-  h = Q->head;
-  if (t > h) { // This means there are more than two tasks in the queue, so it is safe to pop a task from the queue.
+  taskq_idx b = Q->bottom.load(std::memory_order_relaxed) - 1;
+  TaskQueueArray a = Q->array.load(std::memory_order_relaxed);
+  Q->bottom.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  taskq_idx t = Q->top.load(std::memory_order_relaxed);
+  TaskQueueDebug("[%d] TaskQueuePop top %lld bottom %lld\n", CmiMyPe(), (long long)t, (long long)b);
+  if (t < b) { // This means there are more than two tasks in the queue, so it is safe to pop a task from the queue.
     TaskQueueDebug("[%d] returning valid data\n", CmiMyPe());
-    return Q->data[t % TaskQueueSize];
+    return a->data[b & (a->size-1)].load(std::memory_order_relaxed);
   }
 
-  if (t < h) { // The taskqueue is empty and the last task has been stolen by a thief.
-    Q->tail = h;
-    return NULL;
+  void *task = NULL;
+  if (t == b) {
+    // There is only one task so thieves and victim can try to obtain this task simultaneously.
+    task = a->data[b & (a->size-1)].load(std::memory_order_relaxed);
+    if (!Q->top.compare_exchange_strong(t, t+1, std::memory_order_seq_cst, std::memory_order_relaxed)) // Check whether the last task has already been stolen.
+      task = NULL;
   }
-  // From now on, we should handle the situation where there is only one task so thieves and victim can try to obtain this task simultaneously.
-  Q->tail = h + 1;
-#ifdef _WIN32
-  if (h != InterlockedCompareExchange(&(Q->head), h+1,h))
-#else
-  if (!__sync_bool_compare_and_swap(&(Q->head), h, h+1)) // Check whether the last task has already stolen.
-#endif
-    return NULL;
-  return Q->data[t % TaskQueueSize];
+  // The queue is now empty, either way
+  Q->bottom.store(b+1, std::memory_order_relaxed);
+  if (task == NULL && Q->retired != NULL)
+    TaskQueueReclaim(Q);
+  return task;
 }
 
-inline static void* TaskQueueSteal(TaskQueue Q) {
-  taskq_idx h, t;
-  void *task;
+// Take one task from the top of the queue. The caller must have announced its epoch.
+inline static void* TaskQueueStealOne(TaskQueue Q) {
   while (1) {
-    h = Q->head;
-    t = Q->tail;
-    if (h >= t) // The queue is empty or the last element has been stolen by other thieves or popped by the victim.
+    taskq_idx t = Q->top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    taskq_idx b = Q->bottom.load(std::memory_order_acquire);
+    if (t >= b) // The queue is empty or the last element has been stolen by other thieves or popped by the victim.
       return NULL;
-#ifdef _WIN32
-    if (h != InterlockedCompareExchange(&(Q->head), h+1, h))
-#else
-    if (!__sync_bool_compare_and_swap(&(Q->head), h, h+1)) // Check whether the task this thief is trying to steal is still in the queue and not stolen by the other thieves.
-#endif
-      continue;
-    return Q->data[h % TaskQueueSize];
+    TaskQueueArray a = Q->array.load(std::memory_order_seq_cst);
+    void *task = a->data[t & (a->size-1)].load(std::memory_order_relaxed);
+    if (Q->top.compare_exchange_strong(t, t+1, std::memory_order_seq_cst, std::memory_order_relaxed)) // Check whether the task this thief is trying to steal is still in the queue and not stolen by the other thieves.
+      return task;
   }
 }
 
+inline static void* TaskQueueSteal(TaskQueue Q) {
+  std::atomic<taskq_idx> &myEpoch = Q->thiefEpoch[CmiMyRank()];
+  // Announce the epoch before touching the buffer, so the owner does not free it under us
+  myEpoch.store(Q->epoch.load(std::memory_order_acquire), std::memory_order_seq_cst);
+  void *task = TaskQueueStealOne(Q);
+  myEpoch.store(0, std::memory_order_release);
+  return task;
+}
+
+// Number of tasks in the queue; only a hint when called by a thief.
+inline static taskq_idx TaskQueueLength(TaskQueue Q) {
+  taskq_idx n = Q->bottom.load(std::memory_order_relaxed) - Q->top.load(std::memory_order_relaxed);
+  return n > 0 ? n : 0;
+}
+
+// Steal up to half of the tasks in the queue, but at most max, into tasks[] in queue order.
+// Returns the number of tasks stolen. The owner may pop from the bottom concurrently without
+// taking a lock, so a block of tasks cannot be claimed with a single CAS on top; instead the
+// tasks are taken one by one, under a single epoch announcement.
+inline static int TaskQueueStealHalf(TaskQueue Q, void **tasks, int max) {
+  std::atomic<taskq_idx> &myEpoch = Q->thiefEpoch[CmiMyRank()];
+  myEpoch.store(Q->epoch.load(std::memory_order_acquire), std::memory_order_seq_cst);
+  taskq_idx half = (TaskQueueLength(Q) + 1) / 2;
+  int want = half < max ? (int)half : max;
+  int n = 0;
+  while (n < want) {
+    void *task = TaskQueueStealOne(Q);
+    if (task == NULL) break;
+    tasks[n++] = task;
+  }
+  myEpoch.store(0, std::memory_order_release);
+  return n;
+}
+
+#endif /* __cplusplus */
+
 #endif
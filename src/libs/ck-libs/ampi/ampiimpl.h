@@ -23,6 +23,7 @@
 #include "charm++.h"
 #include "tcharm.h"
 #include "tcharmc.h"
+#include "ckflathashmap.h"
 
 #if CMK_AMPI_WITH_ROMIO
 # include "mpio_globals.h"
@@ -211,11 +212,34 @@ extern int AMPI_RDMA_THRESHOLD;
 #define AMPI_ALLTOALL_SHORT_MSG  256
 #define AMPI_ALLTOALL_LONG_MSG   32768
 
+/* alltoall blocks up to this many bytes are aggregated per process and exchanged
+ * only between process leaders, when some process holds several ranks (0 disables) */
+#ifndef AMPI_ALLTOALL_HIER_THRESHOLD_DEFAULT
+#define AMPI_ALLTOALL_HIER_THRESHOLD_DEFAULT 256
+#endif
+
+/* alltoall blocks up to this many bytes among at least AMPI_ALLTOALL_BRUCK_MIN_RANKS
+ * ranks are exchanged with Bruck's algorithm, in log(size) rounds (0 disables) */
+#ifndef AMPI_ALLTOALL_BRUCK_THRESHOLD_DEFAULT
+#define AMPI_ALLTOALL_BRUCK_THRESHOLD_DEFAULT 256
+#endif
+#define AMPI_ALLTOALL_BRUCK_MIN_RANKS 8
+
+extern int AMPI_ALLTOALL_HIER_THRESHOLD;
+extern int AMPI_ALLTOALL_BRUCK_THRESHOLD;
+
 typedef void (*MPI_MigrateFn)(void);
 
 /*
  * AMPI Message Matching (Amm) Interface:
  * messages are matched on 2 ints: [tag, src]
+ *
+ * Entries are kept in one list in arrival order, and each is also linked
+ * into either the bucket for its exact [tag, src] pair or, if it has a
+ * wildcard tag or source, into a separate wildcard list. A lookup for an
+ * exact [tag, src] only has to compare the head of that bucket with the
+ * first matching wildcard entry, so it does not walk every queued entry.
+ * Lookups with wildcards walk the arrival-order list as before.
  */
 #define AMM_TAG   0
 #define AMM_SRC   1
@@ -239,10 +263,14 @@ template <class T>
 class AmmEntry {
  public:
   int tags[AMM_NTAGS]; // [tag, src]
-  AmmEntry<T>* next;
+  AmmEntry<T>* next; // arrival order
+  AmmEntry<T>* prev;
+  AmmEntry<T>* bucketNext; // same [tag, src] bucket, or the wildcard list
+  AmmEntry<T>* bucketPrev;
+  uint64_t seq; // position in arrival order
   T msg; // T is either an AmpiRequest* or an AmpiMsg*
-  AmmEntry(T m) noexcept { tags[AMM_TAG] = m->getTag(); tags[AMM_SRC] = m->getSrcRank(); next = NULL; msg = m; }
-  AmmEntry(int tag, int src, T m) noexcept { tags[AMM_TAG] = tag; tags[AMM_SRC] = src; next = NULL; msg = m; }
+  AmmEntry(T m) noexcept { tags[AMM_TAG] = m->getTag(); tags[AMM_SRC] = m->getSrcRank(); msg = m; }
+  AmmEntry(int tag, int src, T m) noexcept { tags[AMM_TAG] = tag; tags[AMM_SRC] = src; msg = m; }
   AmmEntry() = default;
   ~AmmEntry() = default;
 };
@@ -251,15 +279,34 @@ template <class T, size_t N>
 class Amm {
  public:
   AmmEntry<T>* first;
-  AmmEntry<T>** lasth;
 
  private:
+  struct Bucket {
+    AmmEntry<T>* head = NULL;
+    AmmEntry<T>* tail = NULL;
+  };
+
+  AmmEntry<T>* last;
+  Bucket wildcards;
+  ck::FlatHashMap<uint64_t, Bucket> buckets;
+  uint64_t nextSeq;
+  int count;
   int startIdx;
   std::bitset<N> validEntries;
   std::array<AmmEntry<T>, N> entryPool;
 
+  static inline bool isWildcard(const int tags[AMM_NTAGS]) noexcept {
+    return tags[AMM_TAG] == MPI_ANY_TAG || tags[AMM_SRC] == MPI_ANY_SOURCE;
+  }
+  static inline uint64_t bucketKey(const int tags[AMM_NTAGS]) noexcept {
+    return ((uint64_t)(uint32_t)tags[AMM_TAG] << 32) | (uint32_t)tags[AMM_SRC];
+  }
+  inline void link(AmmEntry<T>* e) noexcept;
+  inline void unlink(AmmEntry<T>* e) noexcept;
+  inline AmmEntry<T>* find(int tag, int src) noexcept;
+
  public:
-  Amm() noexcept : first(NULL), lasth(&first), startIdx(0) { validEntries.reset();  }
+  Amm() noexcept : first(NULL), last(NULL), nextSeq(0), count(0), startIdx(0) { validEntries.reset();  }
   ~Amm() = default;
   inline AmmEntry<T>* newEntry(int tag, int src, T msg) noexcept {
     if (validEntries.all()) {
@@ -2271,6 +2318,7 @@ class ampiParent final : public CBase_ampiParent {
 
   MPI_MigrateFn userAboutToMigrateFn, userJustMigratedFn;
   bool didMigrate{};
+  int lbEpoch{}; // number of collective AMPI_Migrate load balancing steps so far
 
  public:
   bool ampiInitCallDone;
@@ -2359,6 +2407,8 @@ class ampiParent final : public CBase_ampiParent {
   void Checkpoint(int len, const char* dname) noexcept;
   void ResumeThread() noexcept;
   TCharm* getTCharmThread() const noexcept {return thread;}
+  int getLbEpoch() const noexcept { return lbEpoch; }
+  void incLbEpoch() noexcept { lbEpoch++; }
   CMI_WARN_UNUSED_RESULT inline ampiParent* blockOnRecv() noexcept;
   CMI_WARN_UNUSED_RESULT static ampiParent* static_blockOnColl(ampiParent* dis) noexcept;
   CMI_WARN_UNUSED_RESULT CMI_FORCE_INLINE ampiParent* blockOnColl() noexcept {
@@ -2607,6 +2657,45 @@ public:
   }
 };
 
+/*
+Process-level view of a communicator, used by two-level collectives: ranks
+that share a process exchange data with process-local messages, and only
+the lowest rank in each process (its leader) talks to other processes.
+It is built collectively the first time a collective asks for it.
+*/
+class AmpiCollHierarchy {
+ public:
+  bool built = false;
+  bool useful = false; // more than one process, and some process has several ranks
+  int lbEpoch = 0;     // ampiParent::getLbEpoch() when this was built
+  MPI_Comm nodeComm = MPI_COMM_NULL;   // ranks in my process, in rank order
+  MPI_Comm leaderComm = MPI_COMM_NULL; // one leader per process; MPI_COMM_NULL if not a leader
+  int myGroup = 0;     // my process's index, which is also its leader's rank in leaderComm
+  int myIndex = 0;     // my rank in nodeComm
+  int maxGroupSize = 0;
+  // Processes are numbered in order of their lowest rank. The ranks in process g
+  // are groupRanks[groupStart[g]] .. groupRanks[groupStart[g+1]-1], in rank order.
+  std::vector<int> groupStart;
+  std::vector<int> groupRanks;
+
+  int numGroups() const noexcept { return (int)groupStart.size() - 1; }
+  int groupSize(int g) const noexcept { return groupStart[g+1] - groupStart[g]; }
+  int groupRank(int g, int i) const noexcept { return groupRanks[groupStart[g] + i]; }
+
+  void pup(PUP::er &p) noexcept {
+    p|built;
+    p|useful;
+    p|lbEpoch;
+    p|nodeComm;
+    p|leaderComm;
+    p|myGroup;
+    p|myIndex;
+    p|maxGroupSize;
+    p|groupStart;
+    p|groupRanks;
+  }
+};
+
 /*
 An ampi manages the communication of one thread over
 one MPI communicator.
@@ -2643,6 +2732,9 @@ class ampi final : public CBase_ampi {
   // Store generalized request classes created by MPIX_Grequest_class_create
   std::vector<greq_class_desc> greq_classes;
 
+  // Process-level hierarchy for two-level collectives, see getCollHierarchy()
+  AmpiCollHierarchy collHier;
+
  private:
   ampiCommStruct* myComm; // pointer to my ampiCommStruct, owned by ampiParent::comms
   std::vector<int> tmpVec; // stores temp group info
@@ -17,13 +17,15 @@ namespace Ck { namespace IO {
 
     /// How much contiguous data (in bytes) should be assigned to each active PE
     size_t peStripe;
-    /// How much contiguous data (in bytes) should a PE gather before writing it out
+    /// How much contiguous data (in bytes) should a PE gather before writing it
+    /// out, and how much a reader fetches with each read
     size_t writeStripe;
     /// How many PEs should participate in this activity
     int activePEs;
     /// Which PE should be the first to participate in this activity
     int basePE;
-    /// How should active PEs be spaced out?
+    /// How should active PEs be spaced out? The default places one reader on
+    /// each node
     int skipPEs;
 
     void pup(PUP::er &p) {
@@ -67,8 +69,33 @@ namespace Ck { namespace IO {
   /// offset is relative to the file as a whole, not to the session's offset.
   void write(Session session, const char *data, size_t bytes, size_t offset);
 
+  /// Prepare to read data from @arg file, in the window defined by the @arg
+  /// offset and length in @arg bytes. Reader chares spread across the nodes
+  /// fetch the window from the file in large stripe-aligned reads and keep it
+  /// in memory until the session is closed. When all of the data has been
+  /// read in, a SessionReadyMsg will be sent to the @arg ready callback.
+  void startReadSession(File file, size_t bytes, size_t offset, CkCallback ready);
+
+  /// Fetch @arg bytes of data at @arg offset from the window of a read
+  /// session, and send it to @arg after_read in a ReadCompleteMsg. The offset
+  /// is relative to the file as a whole, not to the session's offset. Any
+  /// number of reads may cover the same data, and a broadcast callback delivers
+  /// one copy to each of its targets.
+  void read(Session session, size_t bytes, size_t offset, CkCallback after_read);
+
+  /// Like the above, but the readers put the data directly into @arg data on
+  /// the calling PE using the zero copy API. The buffer must stay valid until
+  /// an empty ReadCompleteMsg has been sent to @arg after_read.
+  void read(Session session, size_t bytes, size_t offset, char *data,
+            CkCallback after_read);
+
+  /// Release the memory held by a read session. All reads from it must have
+  /// completed. @arg closed is called once every reader has freed its data.
+  void closeReadSession(Session session, CkCallback closed);
+
   /// Close a previously-opened file. All sessions on that file must have
-  /// already signalled that they are complete.
+  /// already signalled that they are complete, and all read sessions must have
+  /// been closed.
   void close(File file, CkCallback closed);
 
   class File {
@@ -78,6 +105,8 @@ namespace Ck { namespace IO {
     friend void startSession(File file, size_t bytes, size_t offset, CkCallback ready,
                              const char *commitData, size_t commitBytes, size_t commitOffset,
                              CkCallback complete);
+    friend void startReadSession(File file, size_t bytes, size_t offset,
+                                 CkCallback ready);
     friend void close(File file, CkCallback closed);
     friend class FileReadyMsg;
 
@@ -100,6 +129,7 @@ namespace Ck { namespace IO {
     size_t bytes, offset;
     CkArrayID sessionID;
     friend class Ck::IO::impl::Manager;
+    friend void closeReadSession(Session session, CkCallback closed);
   public:
     Session(int file_, size_t bytes_, size_t offset_,
             CkArrayID sessionID_)
@@ -120,5 +150,15 @@ namespace Ck { namespace IO {
     SessionReadyMsg(Session session_) : session(session_) { }
   };
 
+  class ReadCompleteMsg : public CMessage_ReadCompleteMsg {
+  public:
+    /// Where in the file the data came from
+    size_t offset, bytes;
+    /// The data, unless it was put into the caller's buffer
+    char *data;
+    ReadCompleteMsg(size_t offset_, size_t bytes_)
+      : offset(offset_), bytes(bytes_) { }
+  };
+
 }}
 #endif
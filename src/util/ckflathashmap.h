@@ -0,0 +1,262 @@
+/*
+ * ckflathashmap.h
+ *
+ * An open-addressing hash map for integer keys, such as the 64-bit object IDs
+ * that the array and location managers look up on every message delivery.
+ *
+ * Entries live directly in one power-of-two array and collisions are resolved
+ * with Robin Hood linear probing, so a lookup usually touches a single cache
+ * line and inserting does not allocate per entry. Erasing uses backward-shift
+ * deletion, so there are no tombstones and probe sequences stay short.
+ *
+ * The interface is the subset of std::unordered_map used by the runtime, with
+ * two differences: any insertion may move every entry (invalidating iterators,
+ * pointers and references into the map), and any erase invalidates iterators.
+ */
+
+#ifndef CKFLATHASHMAP_H_
+#define CKFLATHASHMAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ck {
+
+template <typename K, typename V>
+class FlatHashMap
+{
+  static_assert(std::is_integral<K>::value, "FlatHashMap keys must be integers");
+
+public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<K, V>;
+  using size_type = std::size_t;
+
+private:
+  // dist is 0 for an empty slot, otherwise one more than the distance of the entry
+  // from its home slot
+  struct Slot
+  {
+    value_type kv;
+    uint8_t dist = 0;
+  };
+
+  static constexpr size_type npos = ~(size_type)0;
+  static constexpr size_type minCapacity = 16;
+  // Probe sequences are bounded by the dist field; a longer one forces the table to grow
+  static constexpr uint8_t maxDist = 255;
+
+  std::vector<Slot> slots;
+  size_type count_ = 0;
+  size_type mask = 0;
+  int shift = 64;
+
+  // Fibonacci hashing: object IDs differ mostly in their low bits, so take the high
+  // bits of the product to spread them over the whole table
+  size_type homeSlot(K key) const
+  {
+    return (size_type)(((uint64_t)key * 0x9E3779B97F4A7C15ULL) >> shift);
+  }
+
+  size_type findIndex(K key) const
+  {
+    if (slots.empty()) return npos;
+    size_type idx = homeSlot(key);
+    for (uint8_t d = 1; slots[idx].dist >= d; d++)
+    {
+      if (slots[idx].kv.first == key) return idx;
+      idx = (idx + 1) & mask;
+    }
+    return npos;
+  }
+
+  // Place an entry whose key is not in the table yet and return its slot. Richer
+  // entries are displaced along the way, as Robin Hood hashing prescribes.
+  size_type insertNew(value_type&& kv)
+  {
+    const K key = kv.first;
+    size_type idx = homeSlot(key);
+    size_type placed = npos;
+    uint8_t d = 1;
+    for (;;)
+    {
+      Slot& s = slots[idx];
+      if (s.dist == 0)
+      {
+        s.kv = std::move(kv);
+        s.dist = d;
+        return placed == npos ? idx : placed;
+      }
+      if (s.dist < d)
+      {
+        std::swap(s.kv, kv);
+        std::swap(s.dist, d);
+        if (placed == npos) placed = idx;
+      }
+      idx = (idx + 1) & mask;
+      if (++d == maxDist)
+      {
+        // Grow and place the entry still in hand; the original one may have moved
+        rehash(slots.size() * 2);
+        insertNew(std::move(kv));
+        return findIndex(key);
+      }
+    }
+  }
+
+  void rehash(size_type capacity)
+  {
+    std::vector<Slot> old;
+    old.swap(slots);
+    slots.resize(capacity);
+    mask = capacity - 1;
+    shift = 64;
+    for (size_type c = capacity; c > 1; c >>= 1) shift--;
+    for (Slot& s : old)
+      if (s.dist != 0) insertNew(std::move(s.kv));
+  }
+
+  // Make room for one more entry, keeping the load factor at or below 4/5
+  void reserveOneMore()
+  {
+    if (slots.empty())
+      rehash(minCapacity);
+    else if ((count_ + 1) * 5 > slots.size() * 4)
+      rehash(slots.size() * 2);
+  }
+
+  void eraseIndex(size_type idx)
+  {
+    size_type next = (idx + 1) & mask;
+    while (slots[next].dist > 1)
+    {
+      slots[idx].kv = std::move(slots[next].kv);
+      slots[idx].dist = slots[next].dist - 1;
+      idx = next;
+      next = (next + 1) & mask;
+    }
+    slots[idx].kv = value_type();
+    slots[idx].dist = 0;
+    count_--;
+  }
+
+  template <typename Map, typename Ref>
+  class iter_base
+  {
+    friend class FlatHashMap;
+    template <typename, typename>
+    friend class iter_base;
+    Map* map;
+    size_type idx;
+
+    void skipEmpty()
+    {
+      while (idx < map->slots.size() && map->slots[idx].dist == 0) idx++;
+    }
+
+  public:
+    iter_base(Map* m, size_type i) : map(m), idx(i) {}
+    // Allows iterator to const_iterator conversion
+    template <typename M2, typename R2>
+    iter_base(const iter_base<M2, R2>& o) : map(o.map), idx(o.idx) {}
+    Ref& operator*() const { return map->slots[idx].kv; }
+    Ref* operator->() const { return &map->slots[idx].kv; }
+    iter_base& operator++()
+    {
+      idx++;
+      skipEmpty();
+      return *this;
+    }
+    iter_base operator++(int)
+    {
+      iter_base prev = *this;
+      ++*this;
+      return prev;
+    }
+    bool operator==(const iter_base& o) const { return idx == o.idx; }
+    bool operator!=(const iter_base& o) const { return idx != o.idx; }
+  };
+
+public:
+  using iterator = iter_base<FlatHashMap, value_type>;
+  using const_iterator = iter_base<const FlatHashMap, const value_type>;
+
+  FlatHashMap() = default;
+
+  size_type size() const { return count_; }
+  bool empty() const { return count_ == 0; }
+
+  void clear()
+  {
+    slots.clear();
+    count_ = 0;
+    mask = 0;
+    shift = 64;
+  }
+
+  void reserve(size_type n)
+  {
+    size_type capacity = minCapacity;
+    while (n * 5 > capacity * 4) capacity *= 2;
+    if (capacity > slots.size()) rehash(capacity);
+  }
+
+  iterator begin()
+  {
+    iterator it(this, 0);
+    it.skipEmpty();
+    return it;
+  }
+  iterator end() { return iterator(this, slots.size()); }
+  const_iterator begin() const
+  {
+    const_iterator it(this, 0);
+    it.skipEmpty();
+    return it;
+  }
+  const_iterator end() const { return const_iterator(this, slots.size()); }
+
+  iterator find(K key)
+  {
+    size_type idx = findIndex(key);
+    return idx == npos ? end() : iterator(this, idx);
+  }
+  const_iterator find(K key) const
+  {
+    size_type idx = findIndex(key);
+    return idx == npos ? end() : const_iterator(this, idx);
+  }
+  size_type count(K key) const { return findIndex(key) == npos ? 0 : 1; }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(K key, Args&&... args)
+  {
+    size_type idx = findIndex(key);
+    if (idx != npos) return std::make_pair(iterator(this, idx), false);
+    reserveOneMore();
+    idx = insertNew(value_type(key, V(std::forward<Args>(args)...)));
+    count_++;
+    return std::make_pair(iterator(this, idx), true);
+  }
+  std::pair<iterator, bool> insert(const value_type& kv) { return emplace(kv.first, kv.second); }
+
+  V& operator[](K key) { return emplace(key).first->second; }
+
+  size_type erase(K key)
+  {
+    size_type idx = findIndex(key);
+    if (idx == npos) return 0;
+    eraseIndex(idx);
+    return 1;
+  }
+  void erase(const_iterator it) { eraseIndex(it.idx); }
+  void erase(iterator it) { eraseIndex(it.idx); }
+};
+
+}  // namespace ck
+
+#endif /* CKFLATHASHMAP_H_ */
@@ -55,6 +55,7 @@ class bar {
 #define __CK_PUP_H
 
 #include <stdio.h> /*<- for "FILE *" */
+#include <string.h> /*<- for memcpy */
 #include <type_traits>
 #include <utility>
 #include <functional>
@@ -208,6 +209,18 @@ class er {
      IS_UNPACKING = 0x0400,
      TYPE_MASK = 0xFF00
    };
+
+   /// Set by the sizer and the memory PUP::ers, whose bytes() only count or
+   /// copy data in order.  Pup checking adds a record to every bytes() call,
+   /// so the bit is never set then.
+   enum
+   {
+#ifndef CK_CHECK_PUP
+     IS_RAW_MEMORY = 0x10000
+#else
+     IS_RAW_MEMORY = 0
+#endif
+   };
  public:
   virtual ~er();//<- does nothing, but might be needed by some child
 
@@ -249,6 +262,10 @@ class er {
 
   bool hasComments(void) const {return (PUP_er_state&IS_COMMENTS)!=0?true:false;}
 
+  /// True if this is a PUP::sizer, PUP::toMem or PUP::fromMem, so plain data
+  /// can be copied with PUP::rawBytes instead of a virtual bytes() call.
+  bool isRawMemory(void) const {return (PUP_er_state&IS_RAW_MEMORY)!=0?true:false;}
+
 //For single elements, pretend it's an array containing one element
   template<class T>
   void operator()(T &v)               {(*this)(&v,1);}
@@ -393,13 +410,17 @@ class sizer : public er {
 
  public:
   //Write data to the given buffer
-  sizer(const unsigned int purpose = 0) : er(IS_SIZING | purpose), nBytes(0)
+  sizer(const unsigned int purpose = 0) : er(IS_SIZING | IS_RAW_MEMORY | purpose), nBytes(0)
   {
     CmiAssert((purpose & TYPE_MASK) == 0);
   }
 
   //Return the current number of bytes to be packed
   size_t size(void) const {return nBytes;}
+
+  inline void advance(size_t const offset) {
+    nBytes += offset;
+  }
 };
 
 template <class T>
@@ -413,7 +434,7 @@ class mem : public er { //Memory-buffer packers and unpackers
   myByte *origBuf;//Start of memory buffer
   myByte *buf;//Memory buffer (stuff gets packed into/out of here)
   mem(const unsigned int type, myByte* Nbuf, const unsigned int purpose = 0)
-      : er(type | purpose), origBuf(Nbuf), buf(Nbuf)
+      : er(type | IS_RAW_MEMORY | purpose), origBuf(Nbuf), buf(Nbuf)
   {
     CmiAssert((purpose & TYPE_MASK) == 0);
   }
@@ -495,6 +516,18 @@ inline void fromMemBuf(T &t,void *buf,size_t len) {
 		"This means your pup routine doesn't match during packing and unpacking");
 }
 
+/// Same as p(data,n) for n raw bytes, but inlined: p must be isRawMemory().
+inline void rawBytes(er &p, void *data, size_t n) {
+  if (p.isSizing()) {
+    static_cast<sizer &>(p).advance(n);
+  } else {
+    mem &m = static_cast<mem &>(p);
+    if (p.isPacking()) memcpy(m.get_current_pointer(), data, n);
+    else memcpy(data, m.get_current_pointer(), n);
+    m.advance(n);
+  }
+}
+
 /********** PUP::er -- Binary disk file pack/unpack *********/
 class disk : public er {
  protected:
@@ -688,7 +721,7 @@ class wrap_er : public er {
 protected:
 	er &p;
 public:
-	wrap_er(er &p_,unsigned int newFlags=0) :er(p_.getStateFlags()|newFlags), p(p_) {}
+	wrap_er(er &p_,unsigned int newFlags=0) :er((p_.getStateFlags()&~IS_RAW_MEMORY)|newFlags), p(p_) {}
 	virtual size_t size(void) const { return p.size(); }
 	
 	virtual void impl_startSeek(seekBlock &s); /*Begin a seeking block*/
@@ -1011,11 +1044,50 @@ inline void operator|(PUP::er &p, T &t) {
   p.syncComment(PUP::sync_end_object);
 }
 
+namespace details {
+
+/**
+  Traits class: describe types whose pup routine writes nothing but the
+  bytes of their fields, in memory order, like std::pair<int,double>.
+  value says whether T is such a type and size is how many bytes it pups,
+  which can be less than sizeof(T) because of padding.  If dense is set, an
+  array of T is pupped as exactly its memory.  pup_stl.h specializes this for
+  std::pair, std::array and std::complex.
+*/
+template <class T, class Enable = void>
+struct raw_layout {
+  static constexpr bool value = as_bytes<T>::value != 0 && std::is_trivially_copyable<T>::value;
+  static constexpr size_t size = sizeof(T);
+  static constexpr bool dense = value;
+  static inline void copy(er &p, T &t) { rawBytes(p, &t, sizeof(T)); }
+};
+
+}
+
+/**
+  Pup an array of a details::raw_layout type through an isRawMemory()
+  PUP::er.  This writes the same bytes as pupping each element.
+*/
+template <class T>
+inline void PUParrayRaw(er &p, T *t, size_t n) {
+  if (details::raw_layout<T>::dense) {
+    rawBytes(p, (void *)t, n * sizeof(T));
+  } else if (p.isSizing()) {
+    static_cast<sizer &>(p).advance(n * details::raw_layout<T>::size);
+  } else {
+    for (size_t i = 0; i < n; i++) details::raw_layout<T>::copy(p, t[i]);
+  }
+}
+
 /**
   Default PUParray: pup each element.
 */
 template<class T>
 inline void PUParray(PUP::er &p,T *t,size_t n) {
+	if (details::raw_layout<T>::value && p.isRawMemory()) {
+		PUParrayRaw(p,t,n);
+		return;
+	}
 	p.syncComment(PUP::sync_begin_array);
 	for (size_t i=0;i<n;i++) {
 		p.syncComment(PUP::sync_item);
@@ -108,6 +108,40 @@ namespace PUP {
     p|re; p|im;
     v=std::complex<T>(re,im);
   }
+
+  namespace details {
+  // The simple classes above pup their members one after the other, so they
+  // are raw when their members are (see raw_layout in pup.h)
+  template <class A, class B>
+  struct raw_layout<std::pair<A, B>> {
+    typedef typename std::remove_const<A>::type first_type;
+    static constexpr bool value = raw_layout<first_type>::value && raw_layout<B>::value;
+    static constexpr size_t size = raw_layout<first_type>::size + raw_layout<B>::size;
+    static constexpr bool dense = false;
+    static inline void copy(er &p, std::pair<A, B> &v) {
+      raw_layout<first_type>::copy(p, *(first_type *)&v.first);
+      raw_layout<B>::copy(p, v.second);
+    }
+  };
+  template <class T, std::size_t N>
+  struct raw_layout<std::array<T, N>> {
+    static constexpr bool value = raw_layout<T>::value;
+    static constexpr size_t size = N * raw_layout<T>::size;
+    static constexpr bool dense = raw_layout<T>::dense;
+    static inline void copy(er &p, std::array<T, N> &a) {
+      PUParrayRaw(p, a.data(), N);
+    }
+  };
+  template <class T>
+  struct raw_layout<std::complex<T>> {
+    static constexpr bool value = raw_layout<T>::value;
+    static constexpr size_t size = 2 * raw_layout<T>::size;
+    static constexpr bool dense = raw_layout<T>::dense && std::is_trivially_copyable<std::complex<T>>::value;
+    static inline void copy(er &p, std::complex<T> &v) {
+      rawBytes(p, &v, sizeof(v));
+    }
+  };
+  }
   template <class charType> 
   inline void operator|(er &p,typename std::basic_string<charType> &v)
   {
@@ -215,6 +249,27 @@ namespace PUP {
   template <class container, class dtype>
   inline void PUP_stl_container_items(er &p, container &c, size_t nElem)
   {
+    if (details::raw_layout<dtype>::value && p.isRawMemory())
+    { // Copy each item straight to or from memory, no virtual bytes() calls
+      if (p.isUnpacking())
+      {
+        reserve_if_applicable(c, nElem);
+        for (size_t i = 0; i < nElem; ++i)
+        {
+          detail::TemporaryObjectHolder<dtype> n;
+          details::raw_layout<dtype>::copy(p, n.t);
+          emplace(c, std::move(n.t));
+        }
+      }
+      else if (p.isSizing())
+        static_cast<sizer &>(p).advance(nElem * details::raw_layout<dtype>::size);
+      else
+      {
+        for (typename container::iterator it=c.begin(); it!=c.end(); ++it)
+          details::raw_layout<dtype>::copy(p, *(dtype *)&(*it));
+      }
+      return;
+    }
     if (p.isUnpacking())
     {
       reserve_if_applicable(c, nElem);
@@ -307,7 +362,33 @@ namespace PUP {
   inline void PUP_stl_map(er &p,container &c) {
     p.syncComment(sync_begin_list);
     size_t nElem=PUP_stl_container_size(p,c);
-    if (p.isUnpacking())
+    if (details::raw_layout<K>::value && details::raw_layout<V>::value && p.isRawMemory())
+    { // Keys and values are laid out one after the other in the buffer:
+      // copy them directly, no virtual bytes() calls
+      if (p.isUnpacking())
+      {
+        reserve_if_applicable(c, nElem);
+        for (size_t i=0;i<nElem;i++)
+        {
+          detail::TemporaryObjectHolder<K> k;
+          detail::TemporaryObjectHolder<V> v;
+          details::raw_layout<K>::copy(p, k.t);
+          details::raw_layout<V>::copy(p, v.t);
+          c.emplace(std::piecewise_construct, std::forward_as_tuple(std::move(k.t)), std::forward_as_tuple(std::move(v.t)));
+        }
+      }
+      else if (p.isSizing())
+        static_cast<sizer &>(p).advance(nElem * (details::raw_layout<K>::size + details::raw_layout<V>::size));
+      else
+      {
+        for (auto& kv : c)
+        {
+          details::raw_layout<K>::copy(p, *(K *)&kv.first);
+          details::raw_layout<V>::copy(p, kv.second);
+        }
+      }
+    }
+    else if (p.isUnpacking())
       { //Unpacking: Extract each element and insert:
         reserve_if_applicable(c, nElem);
         for (size_t i=0;i<nElem;i++)
@@ -336,7 +417,7 @@ namespace PUP {
 
   template <class T>
   inline void operator|(er &p, typename std::vector<T> &v) {
-    if (PUP::as_bytes<T>::value) {
+    if (PUP::as_bytes<T>::value || details::raw_layout<T>::value) {
       size_t nElem = PUP_stl_container_size(p, v);
       if (p.isUnpacking()) {
         v.resize(nElem);
@@ -412,7 +493,10 @@ using Requires = typename requires_impl<
   template <typename T, std::size_t N,
             Requires<!PUP::as_bytes<T>::value> = nullptr>
   inline void pup(PUP::er& p, std::array<T, N>& a) {
-    std::for_each(a.begin(), a.end(), [&p](T& t) { p | t; });
+    if (details::raw_layout<T>::value && p.isRawMemory())
+      PUParrayRaw(p, a.data(), N);
+    else
+      std::for_each(a.begin(), a.end(), [&p](T& t) { p | t; });
   }
 
   template <typename T, std::size_t N,
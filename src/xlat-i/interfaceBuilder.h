@@ -27,6 +27,7 @@ namespace Builder {
 
   enum BUILDER_ENTRY_ATTRIBUTES
     { THREADED = STHREADED,
+      COROUTINE = SCOROUTINE,
       SYNC = SSYNC,
       IGET = SIGET,
       EXCLUSIVE = SLOCKED,
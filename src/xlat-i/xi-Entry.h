@@ -117,6 +117,7 @@ class WhenStatementEChecker;
 #define SAPPWORK 0x80000  // <- reduction target
 #define SAGGREGATE 0x100000
 #define SWHENIDLE 0x200000 // implies SLOCAL as well
+#define SCOROUTINE 0x400000 // <- C++20 coroutine, see ckcoroutine.h
 
 /* An entry construct */
 class Entry : public Member {
@@ -304,6 +305,7 @@ class Entry : public Member {
   int isSdag(void);
   bool isTramTarget(void);
   int isWhenIdle(void);
+  int isCoroutine(void);
 
   // DMK - Accel support
   int isAccel(void);
@@ -34,8 +34,9 @@ class Parameter {
   bool podType;
 
   friend class ParamList;
-  void pup(XStr& str);
-  void pupArray(XStr& str);
+  void marshallFields(XStr& str, const char* fn, const char* args);
+  void marshallSize(XStr& str);
+  void marshallPack(XStr& str);
   void pupRdma(XStr& str, bool device);
   void copyPtr(XStr& str);
   void check();
@@ -46,11 +47,15 @@ class Parameter {
   void prepareToDeviceCommBuffer(XStr& str, int& index);
   void marshallDeviceRdmaParameters(XStr& str, int& index);
   void marshallArrayData(XStr& str);
+  void beginUnmarshallField(XStr& str, bool redn);
   void beginUnmarshall(XStr& str);
-  void beginUnmarshallArray(XStr& str);
+  void beginUnmarshallRedn(XStr& str);
+  void beginUnmarshallArray(XStr& str, bool redn);
   void beginUnmarshallRdma(XStr& str, bool device);
   void beginUnmarshallSDAGRdma(XStr& str);
+  void beginUnmarshallSDAGCallField(XStr& str, bool redn);
   void beginUnmarshallSDAGCall(XStr& str);
+  void beginUnmarshallSDAGCallRedn(XStr& str);
   void beginUnmarshallSDAGCallRdma(XStr& str, bool device);
   void unmarshallArrayData(XStr& str);
   void unmarshallRegArrayData(XStr& str);
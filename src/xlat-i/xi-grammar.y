@@ -113,7 +113,7 @@ void ReservedWord(int token, int fCol, int lCol);
 %token STACKSIZE
 %token THREADED
 %token TEMPLATE
-%token WHENIDLE SYNC IGET EXCLUSIVE IMMEDIATE SKIPSCHED INLINE VIRTUAL MIGRATABLE AGGREGATE
+%token WHENIDLE COROUTINE SYNC IGET EXCLUSIVE IMMEDIATE SKIPSCHED INLINE VIRTUAL MIGRATABLE AGGREGATE
 %token CREATEHERE CREATEHOME NOKEEP NOTRACE APPWORK
 %token VOID
 %token CONST
@@ -254,6 +254,7 @@ Name		: IDENT
 		| THREADED { ReservedWord(THREADED, @$.first_column, @$.last_column); YYABORT; }
 		| TEMPLATE { ReservedWord(TEMPLATE, @$.first_column, @$.last_column); YYABORT; }
 		| WHENIDLE { ReservedWord(WHENIDLE, @$.first_column, @$.last_column); YYABORT; }
+		| COROUTINE { ReservedWord(COROUTINE, @$.first_column, @$.last_column); YYABORT; }
 		| SYNC { ReservedWord(SYNC, @$.first_column, @$.last_column); YYABORT; }
 		| IGET { ReservedWord(IGET, @$.first_column, @$.last_column); YYABORT; }
 		| EXCLUSIVE { ReservedWord(EXCLUSIVE, @$.first_column, @$.last_column); YYABORT; }
@@ -1010,6 +1011,8 @@ EAttrib		: THREADED
 		{ $$ = STHREADED; }
 		| WHENIDLE
 		{ $$ = SWHENIDLE; }
+		| COROUTINE
+		{ $$ = SCOROUTINE; }
 		| SYNC
 		{ $$ = SSYNC; }
                 | IGET
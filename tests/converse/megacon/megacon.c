@@ -40,6 +40,7 @@ void multisend_init(void);
 void handler_init(void);
 void reduction_init(void);
 void nodereduction_init(void);
+void msgalloc_init(void);
 
 void blkinhand_moduleinit(void);
 void posixth_moduleinit(void);
@@ -61,6 +62,7 @@ void multisend_moduleinit(void);
 void handler_moduleinit(void);
 void reduction_moduleinit(void);
 void nodereduction_moduleinit(void);
+void msgalloc_moduleinit(void);
 
 struct testinfo
 {
@@ -93,6 +95,7 @@ tests[] = {
   { "multisend", multisend_init, multisend_moduleinit,  0,  1 },
   { "reduction", reduction_init, reduction_moduleinit, 0, 1 },
   { "nodereduction", nodereduction_init, nodereduction_moduleinit, 0, 1 },
+  { "msgalloc",  msgalloc_init,  msgalloc_moduleinit,   0,  1 },
   { 0,0,0,0 },
 };
 
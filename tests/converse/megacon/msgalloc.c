@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <converse.h>
+#include <cmimsgalloc.h>
+
+/* Threads the runtime does not know about call CmiAlloc and CmiFree while
+   PE 0 does the same, and each side frees blocks the other allocated.  The
+   threads must not be mistaken for rank 0 by the message allocator. */
+
+void Cpm_megacon_ack(CpmDestination);
+
+#if CMK_SMP && !defined(_WIN32)
+
+#include <pthread.h>
+
+#define MSGALLOC_THREADS 2
+#define MSGALLOC_ROUNDS  20000
+#define MSGALLOC_KEEP    64
+
+typedef struct msgalloc_work_s
+{
+  int id;
+  int **fromPe;   /* allocated by PE 0, freed by the thread */
+  int **toPe;     /* allocated by the thread, freed by PE 0 */
+  int failed;
+}
+*msgalloc_work;
+
+static int msgalloc_size(int i)
+{
+  return 16 + (i * 37) % 2000;
+}
+
+static int *msgalloc_fill(int i, int tag)
+{
+  int j, n = msgalloc_size(i);
+  int *p = (int *)CmiAlloc(n * sizeof(int));
+  for (j=0; j<n; j++) p[j] = tag + j;
+  return p;
+}
+
+static int msgalloc_check(int *p, int i, int tag)
+{
+  int j, n = msgalloc_size(i);
+  for (j=0; j<n; j++)
+    if (p[j] != tag + j) return 0;
+  return 1;
+}
+
+static void *msgalloc_thread(void *arg)
+{
+  msgalloc_work w = (msgalloc_work)arg;
+  CmiMsgAllocStats stats;
+  int i;
+  /* a thread with no PE state has no per-PE counters, nor lists */
+  if (CmiMsgAllocGetStats(&stats)) w->failed = 1;
+  for (i=0; i<MSGALLOC_ROUNDS; i++) {
+    int *p = msgalloc_fill(i, w->id);
+    if (!msgalloc_check(p, i, w->id)) w->failed = 1;
+    CmiFree(p);
+  }
+  for (i=0; i<MSGALLOC_KEEP; i++) {
+    if (!msgalloc_check(w->fromPe[i], i, -1)) w->failed = 1;
+    CmiFree(w->fromPe[i]);
+    w->toPe[i] = msgalloc_fill(i, w->id);
+  }
+  return NULL;
+}
+
+void msgalloc_init()
+{
+  struct msgalloc_work_s work[MSGALLOC_THREADS];
+  pthread_t threads[MSGALLOC_THREADS];
+  int t, i, failed = 0;
+
+  for (t=0; t<MSGALLOC_THREADS; t++) {
+    work[t].id = 1000000 * (t + 1);
+    work[t].fromPe = (int **)malloc(MSGALLOC_KEEP * sizeof(int *));
+    work[t].toPe = (int **)malloc(MSGALLOC_KEEP * sizeof(int *));
+    work[t].failed = 0;
+    for (i=0; i<MSGALLOC_KEEP; i++) work[t].fromPe[i] = msgalloc_fill(i, -1);
+    pthread_create(&threads[t], NULL, msgalloc_thread, &work[t]);
+  }
+  for (i=0; i<MSGALLOC_ROUNDS; i++) {
+    int *p = msgalloc_fill(i, 0);
+    if (!msgalloc_check(p, i, 0)) failed = 1;
+    CmiFree(p);
+  }
+  for (t=0; t<MSGALLOC_THREADS; t++) {
+    pthread_join(threads[t], NULL);
+    for (i=0; i<MSGALLOC_KEEP; i++) {
+      if (!msgalloc_check(work[t].toPe[i], i, work[t].id)) failed = 1;
+      CmiFree(work[t].toPe[i]);
+    }
+    if (work[t].failed) failed = 1;
+    free(work[t].fromPe);
+    free(work[t].toPe);
+  }
+  if (failed) {
+    CmiPrintf("Failure in msgalloc test, data corrupted or a thread used rank 0's lists.\n");
+    exit(1);
+  }
+  Cpm_megacon_ack(CpmSend(0));
+}
+
+#else
+
+void msgalloc_init()
+{
+  CmiPrintf("note: msgalloc requires an SMP build, skipping test.\n");
+  Cpm_megacon_ack(CpmSend(0));
+}
+
+#endif
+
+void msgalloc_moduleinit()
+{
+}